@@ -6,30 +6,51 @@
 #include <QDebug>
 #include <QCryptographicHash>
 #include <QList>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QSet>
+#include <QVariantList>
+#include <QMutexLocker>
+#include <memory>
 
 AuthManager::AuthManager(databasemanager *dbManager)
     : m_dbManager(dbManager)
     , m_lastError("")
+    , m_userPageSize(500)
+    , m_cacheHits(0)
+    , m_cacheMisses(0)
 {
+    // 专用数据库执行线程：线程常驻，使其在连接池中的连接可以被复用
+    m_executor.setMaxThreadCount(4);
+    m_executor.setExpiryTimeout(-1);
 }
 
-// 检查用户名是否存在
-bool AuthManager::userExists(const QString &username)
+AuthManager::~AuthManager()
+{
+    // 等待尚未完成的数据库任务，避免任务访问已销毁的对象
+    m_executor.clear();
+    m_executor.waitForDone();
+
+    const permcachestats stats = getPermissionCacheStats();
+    qDebug() << "权限缓存统计 命中:" << stats.hits << "未命中:" << stats.misses << "缓存条目:" << stats.entries;
+}
+
+// 检查用户名是否存在（线程安全，错误信息写入 error）
+bool AuthManager::doUserExists(const QString &username, QString *error) const
 {
     if (!m_dbManager || !m_dbManager->isConnected()) {
-        m_lastError = "数据库未连接";
+        *error = "数据库未连接";
         return false;
     }
     
-    // 从 databasemanager 获取数据库连接（而不是创建新连接）
-    QSqlDatabase db = m_dbManager->getDatabase();
-    QSqlQuery query(db);
+    // 从连接池借用当前线程的连接（作用域结束时自动归还）
+    connectionguard conn(m_dbManager->getConnectionPool());
     
-    query.prepare("SELECT COUNT(*) FROM NowUsers WHERE username = ?");
-    query.addBindValue(username);
+    // 使用该连接上缓存的预编译语句，只需重新绑定参数
+    QSqlQuery &query = conn.prepared("SELECT COUNT(*) FROM NowUsers WHERE username = ?");
+    query.bindValue(0, username);
     
     if (!query.exec()) {
-        m_lastError = QString("查询用户失败: %1").arg(query.lastError().text());
+        *error = QString("查询用户失败: %1").arg(query.lastError().text());
         query.finish();
         return false;
     }
@@ -45,11 +66,11 @@ bool AuthManager::userExists(const QString &username)
     return result;
 }
 
-// 用户注册
-bool AuthManager::registerUser(const userinfo &user)
+// 用户注册（线程安全，错误信息写入 error）
+bool AuthManager::doRegisterUser(const userinfo &user, QString *error) const
 {
     if (!m_dbManager || !m_dbManager->isConnected()) {
-        m_lastError = "数据库未连接";
+        *error = "数据库未连接";
         return false;
     }
     
@@ -57,62 +78,75 @@ bool AuthManager::registerUser(const userinfo &user)
     
     // 检查用户名是否为空
     if (data.username.isEmpty()) {
-        m_lastError = "用户名不能为空";
+        *error = "用户名不能为空";
         return false;
     }
     
     // 加密密码
     QString passwordHash = hashPassword(data.password);
     
-    // 插入数据库（从 databasemanager 获取连接）
+    // 插入数据库（从连接池借用连接）
     // 参考成功的代码，确保使用新的查询对象并提交事务
-    QSqlDatabase db = m_dbManager->getDatabase();
+    connectionguard conn(m_dbManager->getConnectionPool());
+    QSqlDatabase db = conn.database();
     
     // 确保数据库连接有效
     if (!db.isOpen()) {
-        m_lastError = "数据库连接未打开";
-        qDebug() << m_lastError;
+        *error = "数据库连接未打开";
+        qDebug() << *error;
         return false;
     }
     
-    // 先检查用户名是否存在（使用独立的查询对象，参考成功代码的方式）
-    QSqlQuery checkQuery(db);
-    checkQuery.prepare("SELECT COUNT(*) FROM NowUsers WHERE username = ?");
-    checkQuery.addBindValue(data.username);
-    if (checkQuery.exec() && checkQuery.next()) {
-        if (checkQuery.value(0).toInt() > 0) {
-            m_lastError = "用户名已存在";
-            checkQuery.finish();
-            return false;
-        }
+    // 单条“用户名冲突时跳过”的插入（使用该连接上缓存的预编译语句），
+    // 影响行数为 0 说明用户名已存在，无需先查询；
+    // 达梦的 MERGE 在并发注册同一用户名时可能都未匹配到已有行，后插入的一方违反唯一约束，同样按用户名已存在处理
+    const sqldialect *dialect = m_dbManager->getDialect();
+    const QString insertSQL = dialect->insertIgnore(
+        "NowUsers",
+        QList<sqlcolumn>() << sqlcolumn{"username", "VARCHAR(100)"} << sqlcolumn{"password", "VARCHAR(255)"}
+                           << sqlcolumn{"email", "VARCHAR(255)"} << sqlcolumn{"name", "VARCHAR(100)"},
+        QStringList() << "username");
+    QSqlQuery &query = conn.prepared(insertSQL);
+    query.bindValue(0, data.username);
+    query.bindValue(1, passwordHash);
+    query.bindValue(2, data.email);
+    query.bindValue(3, data.name);
+    
+    // 显式事务：达梦数据库需要提交；SQLite 没有打开的事务时 COMMIT 会失败
+    if (!db.transaction()) {
+        *error = QString("开启事务失败: %1").arg(db.lastError().text());
+        qDebug() << *error;
+        return false;
     }
-    checkQuery.finish();
-    
-    // 创建全新的查询对象用于 INSERT（参考成功代码的方式）
-    QSqlQuery query(db);
-    
-    // 准备 INSERT 语句（参考成功代码的格式）
-    query.prepare("INSERT INTO NowUsers (username, password, email, name) VALUES (?, ?, ?, ?)");
-    query.addBindValue(data.username);
-    query.addBindValue(passwordHash);
-    query.addBindValue(data.email);
-    query.addBindValue(data.name);
     
     // 执行插入
     if (!query.exec()) {
-        m_lastError = QString("注册失败: %1").arg(query.lastError().text());
-        qDebug() << m_lastError;
+        const QSqlError execError = query.lastError();
+        if (dialect->isUniqueViolation(execError)) {
+            *error = "用户名已存在";
+        } else {
+            *error = QString("注册失败: %1").arg(execError.text());
+            qDebug() << *error;
+        }
         query.finish();
+        db.rollback();
         return false;
     }
+    const int inserted = query.numRowsAffected();
     
     // 确保查询完成
     query.finish();
     
-    // 参考成功代码：达梦数据库需要显式提交事务
+    if (inserted == 0) {
+        *error = "用户名已存在";
+        db.rollback();
+        return false;
+    }
+    
     if (!db.commit()) {
-        m_lastError = QString("提交事务失败: %1").arg(db.lastError().text());
-        qDebug() << m_lastError;
+        *error = QString("提交事务失败: %1").arg(db.lastError().text());
+        qDebug() << *error;
+        db.rollback();
         return false;
     }
     
@@ -120,145 +154,467 @@ bool AuthManager::registerUser(const userinfo &user)
     return true;
 }
 
-// 用户登录验证
-bool AuthManager::login(const QString &username, const QString &password)
+// 用户登录验证（线程安全，错误信息写入 error）
+// 一次单行查询取回密码哈希、userid、角色与功能权限位掩码（由覆盖索引直接返回）
+bool AuthManager::doLogin(const QString &username, const QString &password, usersession *session, QString *error) const
 {
     if (!m_dbManager || !m_dbManager->isConnected()) {
-        m_lastError = "数据库未连接";
+        *error = "数据库未连接";
         return false;
     }
     
     if (username.isEmpty() || password.isEmpty()) {
-        m_lastError = "用户名或密码不能为空";
+        *error = "用户名或密码不能为空";
         return false;
     }
     
-    // 查询用户信息（从 databasemanager 获取连接）
-    QSqlDatabase db = m_dbManager->getDatabase();
-    QSqlQuery query(db);
+    // 管理员拥有目录中的全部功能（目录已缓存；须在借用连接之前取得）
+    const permmask adminMask = m_dbManager->getFunctionCatalog().allMask();
     
-    query.prepare("SELECT password FROM NowUsers WHERE username = ?");
-    query.addBindValue(username);
+    // 查询用户信息（从连接池借用连接）
+    connectionguard conn(m_dbManager->getConnectionPool());
+    
+    QSqlQuery &query = conn.prepared("SELECT userid, password, role_type, perm_mask FROM NowUsers WHERE username = ?");
+    query.bindValue(0, username);
     
     if (!query.exec()) {
-        m_lastError = QString("查询用户失败: %1").arg(query.lastError().text());
+        *error = QString("查询用户失败: %1").arg(query.lastError().text());
         query.finish();
         return false;
     }
     
     if (!query.next()) {
-        m_lastError = "用户名不存在";
+        *error = "用户名不存在";
         query.finish();
         return false;
     }
     
+    usersession result;
+    result.userId = query.value(0).toInt();
+    result.username = username;
+    result.roleType = query.value(2).toInt();
+    result.permissions = permmask(query.value(3).toLongLong());
     // 获取存储的密码哈希
-    QString storedHash = query.value(0).toString();
+    QString storedHash = query.value(1).toString();
     query.finish();
     
     // 验证密码
     if (!verifyPassword(password, storedHash)) {
-        m_lastError = "密码错误";
+        *error = "密码错误";
         return false;
     }
     
+    // 管理员拥有所有权限
+    if (result.isAdmin()) {
+        result.permissions = adminMask;
+    }
+    
+    if (session) {
+        *session = result;
+    }
+    
     qDebug() << "用户登录成功:" << username;
     return true;
 }
 
+// 检查用户名是否存在
+bool AuthManager::userExists(const QString &username)
+{
+    return doUserExists(username, &m_lastError);
+}
+
+// 用户注册
+bool AuthManager::registerUser(const userinfo &user)
+{
+    return doRegisterUser(user, &m_lastError);
+}
+
+// 用户登录验证
+bool AuthManager::login(const QString &username, const QString &password, usersession *session)
+{
+    return doLogin(username, password, session, &m_lastError);
+}
+
+// 线程安全的同步登录（在调用线程中借用连接）
+loginresult AuthManager::tryLogin(const QString &username, const QString &password) const
+{
+    loginresult result;
+    result.success = doLogin(username, password, &result.session, &result.error);
+    return result;
+}
+
+// 异步检查用户名是否存在（success 表示用户存在，查询失败时 error 非空）
+QFuture<authresult> AuthManager::userExistsAsync(const QString &username)
+{
+    return QtConcurrent::run(&m_executor, [this, username]() {
+        authresult result;
+        result.success = doUserExists(username, &result.error);
+        return result;
+    });
+}
+
+// 异步用户注册
+QFuture<authresult> AuthManager::registerUserAsync(const userinfo &user)
+{
+    return QtConcurrent::run(&m_executor, [this, user]() {
+        authresult result;
+        result.success = doRegisterUser(user, &result.error);
+        return result;
+    });
+}
+
+// 异步登录验证（成功时结果中带有登录会话）
+QFuture<loginresult> AuthManager::loginAsync(const QString &username, const QString &password)
+{
+    return QtConcurrent::run(&m_executor, [this, username, password]() {
+        return tryLogin(username, password);
+    });
+}
+
+// 异步获取用户的功能权限列表
+QFuture<QList<int>> AuthManager::getUserFunctionPermissionsAsync(const QString &username)
+{
+    return QtConcurrent::run(&m_executor, [this, username]() {
+        return getUserFunctionPermissions(username);
+    });
+}
+
+// 获取用户的功能权限位掩码
+// perm_mask 与权限表同步维护，未命中缓存时一次按用户名的单行查询即可，无需再读取权限表
+permmask AuthManager::getUserPermissionMask(const QString &username) const
+{
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        auto it = m_permCache.constFind(username);
+        if (it != m_permCache.constEnd()) {
+            ++m_cacheHits;
+            return it.value();
+        }
+    }
+    ++m_cacheMisses;
+    
+    if (!m_dbManager || !m_dbManager->isConnected()) {
+        return 0;
+    }
+    
+    const permmask adminMask = m_dbManager->getFunctionCatalog().allMask();
+    connectionguard conn(m_dbManager->getConnectionPool());
+    
+    QSqlQuery &query = conn.prepared("SELECT role_type, perm_mask FROM NowUsers WHERE username = ?");
+    query.bindValue(0, username);
+    permmask mask = 0;
+    bool found = false;
+    if (query.exec() && query.next()) {
+        // 如果是管理员（role_type=1），返回所有权限
+        mask = query.value(0).toInt() == 1 ? adminMask : permmask(query.value(1).toLongLong());
+        found = true;
+    }
+    query.finish();
+    
+    // 只缓存存在的用户，注册新用户不需要清空缓存
+    if (found) {
+        QMutexLocker locker(&m_cacheMutex);
+        m_permCache.insert(username, mask);
+    }
+    return mask;
+}
+
 // 获取用户的功能权限列表
 QList<int> AuthManager::getUserFunctionPermissions(const QString &username) const
 {
-    QList<int> permissions;
+    return functionregistry::toList(getUserPermissionMask(username));
+}
+
+// 批量保存权限修改（线程安全，错误信息写入 error）
+bool AuthManager::doSavePermissionChanges(const QList<permissionchange> &changes, QString *error)
+{
+    if (changes.isEmpty()) {
+        return true;
+    }
     
     if (!m_dbManager || !m_dbManager->isConnected()) {
-        return permissions;
+        *error = "数据库未连接";
+        return false;
+    }
+    
+    connectionguard conn(m_dbManager->getConnectionPool());
+    QSqlDatabase db = conn.database();
+    
+    // 按列组织绑定值，供 execBatch 使用
+    QVariantList userIds;
+    QVariantList functionIds;
+    QVariantList enabledValues;
+    QVariantList changedUsers;
+    QSet<int> seenUsers;
+    for (const permissionchange &change : changes) {
+        userIds << change.userId;
+        functionIds << change.functionId;
+        enabledValues << (change.enabled ? 1 : 0);
+        if (!seenUsers.contains(change.userId)) {
+            seenUsers.insert(change.userId);
+            changedUsers << change.userId;
+        }
     }
     
-    QSqlDatabase db = m_dbManager->getDatabase();
+    // 单条 upsert 语句：SQLite 使用 ON CONFLICT，达梦使用 MERGE INTO
+    const QString upsertSQL = m_dbManager->getDialect()->upsert(
+        "NowUsersPermissions",
+        QList<sqlcolumn>() << sqlcolumn{"userid", "INT"} << sqlcolumn{"function_id", "INT"},
+        QList<sqlcolumn>() << sqlcolumn{"enabled", "INT"});
     
-    // 先检查用户是否是管理员（role_type=1）
-    QSqlQuery roleQuery(db);
-    roleQuery.prepare("SELECT role_type FROM NowUsers WHERE username = ?");
-    roleQuery.addBindValue(username);
-    bool isAdmin = false;
-    if (roleQuery.exec() && roleQuery.next()) {
-        int roleType = roleQuery.value(0).toInt();
-        isAdmin = (roleType == 1);
+    if (!db.transaction()) {
+        *error = QString("开启事务失败: %1").arg(db.lastError().text());
+        return false;
     }
-    roleQuery.finish();
     
-    // 如果是管理员，返回所有权限
-    if (isAdmin) {
-        return QList<int>() << 1 << 2 << 3 << 4 << 5;
+    QSqlQuery upsertQuery(db);
+    upsertQuery.prepare(upsertSQL);
+    upsertQuery.addBindValue(userIds);
+    upsertQuery.addBindValue(functionIds);
+    upsertQuery.addBindValue(enabledValues);
+    bool ok = upsertQuery.execBatch();
+    if (!ok) {
+        *error = QString("保存权限失败: %1").arg(upsertQuery.lastError().text());
+    }
+    upsertQuery.finish();
+    
+    // 按权限表重新计算相关用户的 perm_mask
+    if (ok) {
+        QSqlQuery maskQuery(db);
+        maskQuery.prepare(QString("UPDATE NowUsers SET perm_mask = %1 WHERE userid = ?")
+                          .arg(functionregistry::maskSubquery("NowUsers.userid")));
+        maskQuery.addBindValue(changedUsers);
+        ok = maskQuery.execBatch();
+        if (!ok) {
+            *error = QString("更新权限位掩码失败: %1").arg(maskQuery.lastError().text());
+        }
+        maskQuery.finish();
     }
     
-    // 查询普通用户的功能权限
-    // 先获取userid
-    QSqlQuery userQuery(db);
-    userQuery.prepare("SELECT userid FROM NowUsers WHERE username = ?");
-    userQuery.addBindValue(username);
-    int userId = -1;
-    if (userQuery.exec() && userQuery.next()) {
-        userId = userQuery.value(0).toInt();
+    if (!ok) {
+        qDebug() << *error;
+        db.rollback();
+        return false;
     }
-    userQuery.finish();
     
-    if (userId <= 0) {
-        return permissions;
+    if (!db.commit()) {
+        *error = QString("提交事务失败: %1").arg(db.lastError().text());
+        qDebug() << *error;
+        db.rollback();
+        return false;
     }
     
-    // 查询该用户启用的功能权限
-    QSqlQuery permQuery(db);
-    permQuery.prepare("SELECT function_id FROM NowUsersPermissions WHERE userid = ? AND enabled = 1");
-    permQuery.addBindValue(userId);
+    // 修改按 userid 给出，缓存按用户名保存；保存权限不频繁，直接清空
+    invalidatePermissionCache();
+    qDebug() << "权限已保存，修改项:" << changes.size() << "涉及用户:" << changedUsers.size();
+    return true;
+}
+
+// 批量保存权限修改
+bool AuthManager::savePermissionChanges(const QList<permissionchange> &changes)
+{
+    return doSavePermissionChanges(changes, &m_lastError);
+}
+
+// 异步批量保存权限修改
+QFuture<authresult> AuthManager::savePermissionChangesAsync(const QList<permissionchange> &changes)
+{
+    return QtConcurrent::run(&m_executor, [this, changes]() {
+        authresult result;
+        result.success = doSavePermissionChanges(changes, &result.error);
+        return result;
+    });
+}
+
+// 读取权限矩阵：一次查询取回用户及其功能权限掩码（管理员展开为目录中的全部功能）
+permissionmatrix AuthManager::getPermissionMatrix(const QString &excludeUsername) const
+{
+    permissionmatrix matrix;
+    if (!m_dbManager || !m_dbManager->isConnected()) {
+        matrix.error = "数据库未连接";
+        return matrix;
+    }
     
-    if (permQuery.exec()) {
-        while (permQuery.next()) {
-            permissions.append(permQuery.value(0).toInt());
-        }
+    matrix.catalog = m_dbManager->getFunctionCatalog();
+    const permmask adminMask = matrix.catalog.allMask();
+    connectionguard conn(m_dbManager->getConnectionPool());
+    
+    QSqlQuery query(conn.database());
+    query.setForwardOnly(true);
+    query.prepare("SELECT userid, username, email, role_type, perm_mask "
+                  "FROM NowUsers "
+                  "WHERE username != ? "
+                  "ORDER BY username");
+    query.addBindValue(excludeUsername);
+    
+    if (!query.exec()) {
+        matrix.error = QString("加载用户权限失败: %1").arg(query.lastError().text());
+        qDebug() << matrix.error;
+        return matrix;
     }
-    permQuery.finish();
     
-    return permissions;
+    while (query.next()) {
+        permissionrow row;
+        row.userId = query.value(0).toInt();
+        row.username = query.value(1).toString();
+        row.email = query.value(2).toString();
+        row.mask = query.value(3).toInt() == 1 ? adminMask : permmask(query.value(4).toLongLong());
+        matrix.rows.append(row);
+    }
+    query.finish();
+    
+    matrix.success = true;
+    return matrix;
+}
+
+// 异步读取权限矩阵
+QFuture<permissionmatrix> AuthManager::getPermissionMatrixAsync(const QString &excludeUsername)
+{
+    return QtConcurrent::run(&m_executor, [this, excludeUsername]() {
+        return getPermissionMatrix(excludeUsername);
+    });
+}
+
+// 清空权限缓存
+void AuthManager::invalidatePermissionCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_permCache.clear();
+}
+
+// 获取权限缓存统计
+permcachestats AuthManager::getPermissionCacheStats() const
+{
+    permcachestats stats;
+    stats.hits = m_cacheHits.load();
+    stats.misses = m_cacheMisses.load();
+    QMutexLocker locker(&m_cacheMutex);
+    stats.entries = m_permCache.size();
+    return stats;
 }
 
 // 检查用户是否有指定功能的权限
 bool AuthManager::hasFunctionPermission(const QString &username, int functionId) const
 {
-    QList<int> permissions = getUserFunctionPermissions(username);
-    return permissions.contains(functionId);
+    return functionregistry::has(getUserPermissionMask(username), functionId);
 }
 
 // 获取所有用户列表
 QList<userinfo> AuthManager::getAllUsers() const
 {
     QList<userinfo> users;
+    forEachUser([&users](const userinfodata &data) {
+        userinfo user;
+        user.setUserData(data);
+        users.append(user);
+        return true;
+    });
+    return users;
+}
+
+// 键集分页：WHERE username > ? ORDER BY username 可直接沿 username 唯一索引读取，
+// 多取一行用于判断是否还有下一页
+userpage AuthManager::getUsersPage(const QString &afterUsername, int pageSize) const
+{
+    userpage page;
+    if (pageSize <= 0) {
+        pageSize = m_userPageSize;
+    }
     
     if (!m_dbManager || !m_dbManager->isConnected()) {
-        return users;
+        page.error = "数据库未连接";
+        return page;
     }
     
-    QSqlDatabase db = m_dbManager->getDatabase();
-    QSqlQuery query(db);
+    connectionguard conn(m_dbManager->getConnectionPool());
+    const QString sql = m_dbManager->getDialect()->limit(
+        "SELECT username, email, name FROM NowUsers WHERE username > ? ORDER BY username", pageSize + 1);
+    // 行数写在语句文本中，只有默认页大小的语句进入连接的预编译缓存（缓存不设上限），
+    // 其他页大小使用一次性的查询
+    std::unique_ptr<QSqlQuery> adhocQuery;
+    QSqlQuery *query = nullptr;
+    if (pageSize == m_userPageSize) {
+        query = &conn.prepared(sql);
+    } else {
+        adhocQuery.reset(new QSqlQuery(conn.database()));
+        adhocQuery->setForwardOnly(true);
+        adhocQuery->prepare(sql);
+        query = adhocQuery.get();
+    }
+    query->bindValue(0, afterUsername);
     
-    query.prepare("SELECT username, email, name FROM NowUsers ORDER BY username");
+    if (!query->exec()) {
+        page.error = QString("查询用户列表失败: %1").arg(query->lastError().text());
+        query->finish();
+        return page;
+    }
     
-    if (query.exec()) {
-        while (query.next()) {
-            userinfodata data;
-            data.username = query.value(0).toString();
-            data.email = query.value(1).toString();
-            data.name = query.value(2).toString();
-            
-            userinfo user;
-            user.setUserData(data);
-            users.append(user);
+    page.users.reserve(pageSize);
+    while (query->next()) {
+        if (page.users.size() == pageSize) {
+            page.hasMore = true;
+            break;
         }
+        userinfodata data;
+        data.username = query->value(0).toString();
+        data.email = query->value(1).toString();
+        data.name = query->value(2).toString();
+        
+        userinfo user;
+        user.setUserData(data);
+        page.users.append(user);
     }
-    query.finish();
+    query->finish();
     
-    return users;
+    if (!page.users.isEmpty()) {
+        page.nextCursor = page.users.last().getUserData().username;
+    }
+    page.success = true;
+    return page;
+}
+
+void AuthManager::setUserPageSize(int pageSize)
+{
+    m_userPageSize = qMax(1, pageSize);
+}
+
+int AuthManager::userPageSize() const
+{
+    return m_userPageSize;
+}
+
+// 只进查询逐行回调，驱动无需缓存已读取的行
+bool AuthManager::forEachUser(const std::function<bool(const userinfodata &)> &callback, QString *error) const
+{
+    if (!m_dbManager || !m_dbManager->isConnected()) {
+        if (error) {
+            *error = "数据库未连接";
+        }
+        return false;
+    }
+    
+    connectionguard conn(m_dbManager->getConnectionPool());
+    QSqlQuery query(conn.database());
+    query.setForwardOnly(true);
+    
+    if (!query.exec("SELECT username, email, name FROM NowUsers ORDER BY username")) {
+        if (error) {
+            *error = QString("查询用户列表失败: %1").arg(query.lastError().text());
+        }
+        return false;
+    }
+    
+    userinfodata data;
+    while (query.next()) {
+        data.username = query.value(0).toString();
+        data.email = query.value(1).toString();
+        data.name = query.value(2).toString();
+        if (!callback(data)) {
+            break;
+        }
+    }
+    query.finish();
+    return true;
 }
 
 // 获取数据库管理器
@@ -267,6 +623,20 @@ databasemanager* AuthManager::getDatabaseManager() const
     return m_dbManager;
 }
 
+// 获取功能目录（未连接数据库时为内置功能）
+functioncatalog AuthManager::getFunctionCatalog() const
+{
+    return m_dbManager ? m_dbManager->getFunctionCatalog() : functioncatalog();
+}
+
+// 异步获取功能目录（尚未缓存时在数据库线程中读取）
+QFuture<functioncatalog> AuthManager::getFunctionCatalogAsync()
+{
+    return QtConcurrent::run(&m_executor, [this]() {
+        return getFunctionCatalog();
+    });
+}
+
 // 获取错误信息
 QString AuthManager::getLastError() const
 {
@@ -2,15 +2,84 @@
 #define AUTHMANAGER_H
 
 #include <QString>
+#include <QList>
+#include <QFuture>
+#include <QThreadPool>
+#include <QHash>
+#include <QMutex>
+#include <atomic>
+#include <functional>
 #include "userinfo.h"
+#include "usersession.h"
+#include "../database/functioncatalog.h"
 
 class databasemanager;
 
+// 一项权限修改（用于批量保存）
+struct permissionchange
+{
+    int userId = -1;
+    int functionId = 0;
+    bool enabled = false;
+};
+
+// 权限缓存统计
+struct permcachestats
+{
+    qint64 hits = 0;
+    qint64 misses = 0;
+    int entries = 0;
+};
+
+// 异步调用结果
+struct authresult
+{
+    bool success = false;
+    QString error;
+};
+
+// 异步登录结果
+struct loginresult
+{
+    bool success = false;
+    QString error;
+    usersession session;
+};
+
+// 权限矩阵中的一个用户
+struct permissionrow
+{
+    int userId = -1;
+    QString username;
+    QString email;
+    permmask mask = 0;   // 管理员为目录中的全部功能
+};
+
+// 权限矩阵读取结果（权限管理对话框）
+struct permissionmatrix
+{
+    bool success = false;
+    QString error;
+    functioncatalog catalog;       // 功能列
+    QList<permissionrow> rows;     // 按用户名排序
+};
+
+// 用户分页结果（按用户名键集分页）
+struct userpage
+{
+    bool success = false;
+    QString error;
+    QList<userinfo> users;
+    QString nextCursor;    // 下一页的起点（本页最后一个用户名），作为 afterUsername 传入
+    bool hasMore = false;  // 是否还有下一页
+};
+
 class AuthManager
 {
 public:
     // 构造函数
     AuthManager(databasemanager *dbManager);
+    ~AuthManager();
     
     // 检查用户名是否存在
     bool userExists(const QString &username);
@@ -18,34 +87,90 @@ public:
     // 用户注册
     bool registerUser(const userinfo &user);
     
-    // 用户登录验证
-    bool login(const QString &username, const QString &password);
+    // 用户登录验证（一次查询取回身份、角色与权限，成功时写入 session）
+    bool login(const QString &username, const QString &password, usersession *session = nullptr);
+    
+    // 线程安全的同步登录：结果（含错误信息）通过返回值给出，不写 m_lastError，可在多个线程中同时调用
+    loginresult tryLogin(const QString &username, const QString &password) const;
+    
+    // 异步接口：在专用数据库线程中执行，不阻塞界面线程
+    QFuture<authresult> userExistsAsync(const QString &username);
+    QFuture<authresult> registerUserAsync(const userinfo &user);
+    QFuture<loginresult> loginAsync(const QString &username, const QString &password);
+    QFuture<QList<int>> getUserFunctionPermissionsAsync(const QString &username);
     
-    // 获取用户的功能权限列表 (返回function_id列表，1-5)
+    // 获取用户的功能权限位掩码（读取 NowUsers.perm_mask 一列，管理员为全部功能）
+    // 结果按用户名缓存，命中时不访问数据库；savePermissionChanges 成功后清空缓存
+    permmask getUserPermissionMask(const QString &username) const;
+    
+    // 获取用户的功能权限列表（function_id 升序）
     QList<int> getUserFunctionPermissions(const QString &username) const;
     
     // 检查用户是否有指定功能的权限
     bool hasFunctionPermission(const QString &username, int functionId) const;
     
-    // 获取所有用户列表（用于权限管理）
+    // 在一个事务中批量保存权限修改（批量 upsert，并重新计算相关用户的 perm_mask）
+    bool savePermissionChanges(const QList<permissionchange> &changes);
+    QFuture<authresult> savePermissionChangesAsync(const QList<permissionchange> &changes);
+    
+    // 读取权限矩阵：除 excludeUsername 外的全部用户及其功能权限掩码，连同功能目录一起返回
+    permissionmatrix getPermissionMatrix(const QString &excludeUsername) const;
+    QFuture<permissionmatrix> getPermissionMatrixAsync(const QString &excludeUsername);
+    
+    // 权限缓存：其他进程修改了权限时可调用 invalidatePermissionCache 清空
+    void invalidatePermissionCache();
+    permcachestats getPermissionCacheStats() const;
+    
+    // 获取所有用户列表（一次取回全部用户，用户量大时改用 getUsersPage 或 forEachUser）
     QList<userinfo> getAllUsers() const;
     
+    // 按用户名分页获取用户：返回用户名大于 afterUsername 的前 pageSize 个用户（首页传空字符串）
+    // 键集分页不使用 OFFSET，每一页的代价与页码无关；pageSize <= 0 时使用 setUserPageSize 设置的值
+    userpage getUsersPage(const QString &afterUsername = QString(), int pageSize = 0) const;
+    
+    // 默认分页大小（默认 500）
+    void setUserPageSize(int pageSize);
+    int userPageSize() const;
+    
+    // 按用户名顺序逐个回调全部用户（只进查询，不缓存结果）；回调返回 false 时提前停止
+    // 回调在持有数据库连接时执行，不应在其中执行耗时操作或再次访问数据库
+    bool forEachUser(const std::function<bool(const userinfodata &)> &callback, QString *error = nullptr) const;
+    
     // 获取数据库管理器（用于权限管理对话框）
     databasemanager* getDatabaseManager() const;
     
+    // 获取功能目录（主页面按钮、权限矩阵的列；启动时读取一次后缓存）
+    functioncatalog getFunctionCatalog() const;
+    QFuture<functioncatalog> getFunctionCatalogAsync();
+    
     // 获取错误信息
     QString getLastError() const;
 
+    // 密码加密（批量导入、数据生成工具与登录使用同一算法）
+    static QString hashPassword(const QString &password);
+
 private:
-    // 密码加密
-    QString hashPassword(const QString &password);
-    
+    Q_DISABLE_COPY(AuthManager)
+
+    // 实际执行数据库操作的实现（不访问 m_lastError，可在任意线程调用）
+    bool doUserExists(const QString &username, QString *error) const;
+    bool doRegisterUser(const userinfo &user, QString *error) const;
+    bool doLogin(const QString &username, const QString &password, usersession *session, QString *error) const;
+    bool doSavePermissionChanges(const QList<permissionchange> &changes, QString *error);
+
     // 密码验证
-    bool verifyPassword(const QString &password, const QString &hash);
+    static bool verifyPassword(const QString &password, const QString &hash);
     
     // 成员变量
     databasemanager *m_dbManager;
     QString m_lastError;
+    QThreadPool m_executor;  // 专用数据库执行器
+    std::atomic<int> m_userPageSize;
+    
+    mutable QMutex m_cacheMutex;
+    mutable QHash<QString, permmask> m_permCache;  // 用户名 -> 有效权限位掩码（管理员已展开）
+    mutable std::atomic<qint64> m_cacheHits;
+    mutable std::atomic<qint64> m_cacheMisses;
 };
 
 #endif // AUTHMANAGER_H
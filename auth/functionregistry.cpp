@@ -0,0 +1,34 @@
+#include "functionregistry.h"
+#include <QStringList>
+
+QList<int> functionregistry::toList(permmask mask)
+{
+    QList<int> functionIds;
+    for (int functionId = 1; functionId <= MAX_FUNCTIONS && mask != 0; ++functionId) {
+        if (has(mask, functionId)) {
+            functionIds.append(functionId);
+            mask &= ~bit(functionId);
+        }
+    }
+    return functionIds;
+}
+
+permmask functionregistry::fromList(const QList<int> &functionIds)
+{
+    permmask mask = 0;
+    for (int functionId : functionIds) {
+        mask |= bit(functionId);
+    }
+    return mask;
+}
+
+QString functionregistry::maskSubquery(const QString &userIdExpr)
+{
+    QStringList cases;
+    for (int functionId = 1; functionId <= MAX_FUNCTIONS; ++functionId) {
+        cases << QString("WHEN %1 THEN %2").arg(functionId).arg(bit(functionId));
+    }
+    return QString("(SELECT COALESCE(SUM(CASE pm.function_id %1 ELSE 0 END), 0) "
+                   "FROM NowUsersPermissions pm WHERE pm.userid = %2 AND pm.enabled = 1)")
+        .arg(cases.join(' '), userIdExpr);
+}
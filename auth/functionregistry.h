@@ -0,0 +1,84 @@
+#ifndef FUNCTIONREGISTRY_H
+#define FUNCTIONREGISTRY_H
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+
+// 功能权限位掩码：第 function_id-1 位表示该功能是否启用（与 NowUsers.perm_mask 一致）
+typedef quint64 permmask;
+
+// 一个内置功能
+struct functiondef
+{
+    int id;              // function_id（1..MAX_FUNCTIONS，决定在掩码中的位）
+    const char *label;   // 显示名称（UTF-8）
+};
+
+// 功能编号与掩码位的对应规则，以及内置功能表
+// 运行时的功能列表以 Functions 表为准（见 functioncatalog），FUNCTIONS 是该表的初始内容，
+// 也是目录表不可用时的后备；权限判断是一次位运算，不分配内存
+class functionregistry
+{
+public:
+    // 掩码按有符号 BIGINT 存储，最多 63 个功能
+    static constexpr int MAX_FUNCTIONS = 63;
+
+    static constexpr functiondef FUNCTIONS[] = {
+        {1, "功能一"},
+        {2, "功能二"},
+        {3, "功能三"},
+        {4, "功能四"},
+        {5, "功能五"},
+    };
+
+    static constexpr int COUNT = int(sizeof(FUNCTIONS) / sizeof(FUNCTIONS[0]));
+
+    // 编号能否放进掩码
+    static constexpr bool isValidId(int functionId)
+    {
+        return functionId >= 1 && functionId <= MAX_FUNCTIONS;
+    }
+
+    // 功能对应的位（无效编号为 0）
+    static constexpr permmask bit(int functionId)
+    {
+        return isValidId(functionId) ? permmask(1) << (functionId - 1) : permmask(0);
+    }
+
+    // 是否拥有指定功能
+    static constexpr bool has(permmask mask, int functionId)
+    {
+        return (mask & bit(functionId)) != 0;
+    }
+
+    // 掩码与 function_id 列表互相转换（列表按编号升序）
+    static QList<int> toList(permmask mask);
+    static permmask fromList(const QList<int> &functionIds);
+
+    // 由 NowUsersPermissions 中已启用的行计算某个用户掩码的标量子查询，userIdExpr 为外层的 userid 表达式
+    // 用 CASE 而不是位移运算，SQLite 与 DM 通用；(userid, function_id) 唯一，SUM 与按位或等价
+    // CASE 覆盖全部可用编号，与目录中有哪些功能无关（结构迁移中也可使用）
+    static QString maskSubquery(const QString &userIdExpr);
+
+    // 编号在 1..MAX_FUNCTIONS 内且互不重复（编译期检查）
+    static constexpr bool hasValidIds()
+    {
+        for (int i = 0; i < COUNT; ++i) {
+            if (FUNCTIONS[i].id < 1 || FUNCTIONS[i].id > MAX_FUNCTIONS) {
+                return false;
+            }
+            for (int j = i + 1; j < COUNT; ++j) {
+                if (FUNCTIONS[i].id == FUNCTIONS[j].id) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+static_assert(functionregistry::COUNT > 0 && functionregistry::COUNT <= functionregistry::MAX_FUNCTIONS,
+              "功能数量超出掩码位数");
+static_assert(functionregistry::hasValidIds(), "功能编号必须在 1..63 之间且不能重复");
+
+#endif // FUNCTIONREGISTRY_H
@@ -0,0 +1,184 @@
+#include "permissionexporter.h"
+#include "../database/databasemanager.h"
+#include <QSaveFile>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QDebug>
+
+namespace {
+
+// 输出缓冲区达到该大小时写入设备
+const int WRITE_BUFFER_SIZE = 64 * 1024;
+
+// CSV 字段转义：包含逗号、引号或换行时加引号
+void appendField(QByteArray *buffer, const QString &text)
+{
+    if (text.contains(',') || text.contains('"') || text.contains('\n') || text.contains('\r')) {
+        QString escaped = text;
+        escaped.replace("\"", "\"\"");
+        buffer->append('"');
+        buffer->append(escaped.toUtf8());
+        buffer->append('"');
+    } else {
+        buffer->append(text.toUtf8());
+    }
+}
+
+}
+
+permissionexporter::permissionexporter(databasemanager *dbManager)
+    : m_dbManager(dbManager)
+    , m_progressInterval(10000)
+    , m_cancelled(false)
+{
+}
+
+void permissionexporter::setProgressInterval(int users)
+{
+    m_progressInterval = qMax(1, users);
+}
+
+void permissionexporter::setProgressCallback(const std::function<void(const exportprogress &)> &callback)
+{
+    m_progressCallback = callback;
+}
+
+void permissionexporter::cancel()
+{
+    m_cancelled = true;
+}
+
+exportsummary permissionexporter::exportFile(const QString &path)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        exportsummary summary;
+        summary.error = QString("无法写入文件 %1: %2").arg(path, file.errorString());
+        return summary;
+    }
+
+    exportsummary summary = exportDevice(&file);
+    if (!summary.success) {
+        file.cancelWriting();
+        return summary;
+    }
+    if (!file.commit()) {
+        summary.success = false;
+        summary.error = QString("保存文件 %1 失败: %2").arg(path, file.errorString());
+    }
+    return summary;
+}
+
+exportsummary permissionexporter::exportDevice(QIODevice *device)
+{
+    exportsummary summary;
+    m_cancelled = false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!m_dbManager || !m_dbManager->isConnected()) {
+        summary.error = "数据库未连接";
+        return summary;
+    }
+
+    // 每个功能一列，按功能目录的顺序
+    const functioncatalog catalog = m_dbManager->getFunctionCatalog();
+    const QList<functioninfo> &functions = catalog.functions();
+    // 管理员（role_type=1）的有效权限为目录中的全部功能，与 AuthManager::getUserPermissionMask 一致
+    const permmask adminMask = catalog.allMask();
+
+    connectionguard conn(m_dbManager->getConnectionPool());
+    if (!conn.isValid()) {
+        summary.error = QString("获取数据库连接失败: %1").arg(m_dbManager->getConnectionPool()->getLastError());
+        return summary;
+    }
+    QSqlDatabase db = conn.database();
+
+    // 用户总数只用于显示进度，失败时不影响导出
+    {
+        QSqlQuery countQuery(db);
+        countQuery.setForwardOnly(true);
+        if (countQuery.exec("SELECT COUNT(*) FROM NowUsers") && countQuery.next()) {
+            summary.progress.usersTotal = countQuery.value(0).toLongLong();
+        }
+    }
+
+    // 每个用户一行，功能权限取 perm_mask（管理员按全部功能导出）
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT userid, username, email, name, role_type, perm_mask "
+                    "FROM NowUsers ORDER BY username")) {
+        summary.error = QString("查询用户权限失败: %1").arg(query.lastError().text());
+        return summary;
+    }
+
+    QByteArray buffer;
+    buffer.reserve(WRITE_BUFFER_SIZE + 1024);
+    buffer.append("userid,username,email,name,role_type");
+    for (const functioninfo &function : functions) {
+        buffer.append(",function_").append(QByteArray::number(function.id));
+    }
+    buffer.append('\n');
+
+    auto writeBuffer = [&]() {
+        if (device->write(buffer) != buffer.size()) {
+            summary.error = QString("写入失败: %1").arg(device->errorString());
+            return false;
+        }
+        summary.progress.bytesWritten += buffer.size();
+        buffer.clear();
+        return true;
+    };
+
+    while (query.next()) {
+        buffer.append(QByteArray::number(query.value(0).toInt())).append(',');
+        appendField(&buffer, query.value(1).toString());
+        buffer.append(',');
+        appendField(&buffer, query.value(2).toString());
+        buffer.append(',');
+        appendField(&buffer, query.value(3).toString());
+        const int roleType = query.value(4).toInt();
+        buffer.append(',').append(QByteArray::number(roleType));
+        const permmask mask = roleType == 1 ? adminMask : permmask(query.value(5).toLongLong());
+        for (const functioninfo &function : functions) {
+            buffer.append(functionregistry::has(mask, function.id) ? ",1" : ",0");
+        }
+        buffer.append('\n');
+        ++summary.progress.usersWritten;
+
+        if (buffer.size() >= WRITE_BUFFER_SIZE && !writeBuffer()) {
+            return summary;
+        }
+        if (summary.progress.usersWritten % m_progressInterval == 0) {
+            if (m_cancelled) {
+                summary.cancelled = true;
+                summary.elapsedMs = timer.elapsed();
+                return summary;
+            }
+            if (m_progressCallback) {
+                m_progressCallback(summary.progress);
+            }
+        }
+    }
+
+    if (query.lastError().isValid()) {
+        summary.error = QString("读取用户权限失败: %1").arg(query.lastError().text());
+        return summary;
+    }
+    query.finish();
+
+    if (!writeBuffer()) {
+        return summary;
+    }
+
+    if (m_progressCallback) {
+        m_progressCallback(summary.progress);
+    }
+    summary.success = true;
+    summary.elapsedMs = timer.elapsed();
+    qDebug() << "权限矩阵导出完成 用户:" << summary.progress.usersWritten
+             << "字节:" << summary.progress.bytesWritten << "用时(ms):" << summary.elapsedMs;
+    return summary;
+}
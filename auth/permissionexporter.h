@@ -0,0 +1,59 @@
+#ifndef PERMISSIONEXPORTER_H
+#define PERMISSIONEXPORTER_H
+
+#include <QString>
+#include <atomic>
+#include <functional>
+
+class databasemanager;
+class QIODevice;
+
+// 导出进度
+struct exportprogress
+{
+    qint64 usersWritten = 0;
+    qint64 usersTotal = 0;     // 开始导出时的用户总数（仅用于显示进度）
+    qint64 bytesWritten = 0;
+};
+
+// 导出结果
+struct exportsummary
+{
+    bool success = false;
+    bool cancelled = false;
+    QString error;
+    exportprogress progress;
+    qint64 elapsedMs = 0;
+};
+
+// 用户权限矩阵导出（CSV：userid,username,email,name,role_type,功能目录中每个功能一列 function_<id>）
+// 按用户名排序读取 NowUsers（功能权限取 perm_mask），用只进查询逐行读取后直接写出，
+// 不在内存中保存结果集，百万级用户也只占用常量内存
+class permissionexporter
+{
+public:
+    explicit permissionexporter(databasemanager *dbManager);
+
+    // 每写出多少个用户回调一次进度（默认 10000）
+    void setProgressInterval(int users);
+
+    // 进度回调（在执行导出的线程中调用）
+    void setProgressCallback(const std::function<void(const exportprogress &)> &callback);
+
+    // 请求取消（线程安全）
+    void cancel();
+
+    // 导出到文件：先写入临时文件，成功后替换目标文件，取消或失败时不留下不完整的文件
+    exportsummary exportFile(const QString &path);
+
+    // 导出到已打开的设备（如标准输出）
+    exportsummary exportDevice(QIODevice *device);
+
+private:
+    databasemanager *m_dbManager;
+    int m_progressInterval;
+    std::function<void(const exportprogress &)> m_progressCallback;
+    std::atomic<bool> m_cancelled;
+};
+
+#endif // PERMISSIONEXPORTER_H
@@ -0,0 +1,449 @@
+#include "userimporter.h"
+#include "authmanager.h"
+#include "../database/databasemanager.h"
+#include "../database/userbulkwriter.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
+#include <limits>
+
+namespace {
+
+// 与数据库比对用户名时每条 IN 查询携带的用户名数
+const int EXISTS_BATCH = 500;
+
+// 默认列顺序（无表头时）
+const int DEFAULT_USERNAME = 0;
+const int DEFAULT_EMAIL = 1;
+const int DEFAULT_NAME = 2;
+const int DEFAULT_PASSWORD = 3;
+const int DEFAULT_PERMISSIONS = 4;
+
+bool containsCjk(const QString &text)
+{
+    for (const QChar &ch : text) {
+        const ushort unicode = ch.unicode();
+        if (unicode >= 0x4E00 && unicode <= 0x9FFF) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString fieldAt(const QStringList &fields, int index)
+{
+    return index >= 0 && index < fields.size() ? fields.at(index).trimmed() : QString();
+}
+
+}
+
+userimporter::userimporter(databasemanager *dbManager)
+    : m_dbManager(dbManager)
+    , m_chunkSize(5000)
+    , m_maxErrors(1000)
+    , m_cancelled(false)
+    , m_colUsername(DEFAULT_USERNAME)
+    , m_colEmail(DEFAULT_EMAIL)
+    , m_colName(DEFAULT_NAME)
+    , m_colPassword(DEFAULT_PASSWORD)
+    , m_colPermissions(DEFAULT_PERMISSIONS)
+{
+}
+
+void userimporter::setChunkSize(int rows)
+{
+    m_chunkSize = qMax(1, rows);
+}
+
+void userimporter::setMaxErrors(int count)
+{
+    m_maxErrors = qMax(0, count);
+}
+
+void userimporter::setProgressCallback(const std::function<void(const importprogress &)> &callback)
+{
+    m_progressCallback = callback;
+}
+
+void userimporter::cancel()
+{
+    m_cancelled = true;
+}
+
+importsummary userimporter::importFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        importsummary summary;
+        summary.error = QString("无法打开文件 %1: %2").arg(path, file.errorString());
+        return summary;
+    }
+    return importDevice(&file, QFileInfo(file).size());
+}
+
+importsummary userimporter::importDevice(QIODevice *device, qint64 bytesTotal)
+{
+    importsummary summary;
+    summary.progress.bytesTotal = bytesTotal;
+    m_cancelled = false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!m_dbManager || !m_dbManager->isConnected()) {
+        summary.error = "数据库未连接";
+        return summary;
+    }
+
+    m_functions = m_dbManager->getFunctionCatalog();
+
+    // 整个导入过程使用同一个连接（连接只能在当前线程使用，哈希计算不访问数据库）
+    connectionguard conn(m_dbManager->getConnectionPool());
+    if (!conn.isValid()) {
+        summary.error = QString("获取数据库连接失败: %1").arg(m_dbManager->getConnectionPool()->getLastError());
+        return summary;
+    }
+
+    userbulkwriter writer(conn.database());
+    // 由导入器控制何时写入，写入器本身不自动分批
+    writer.setChunkSize(std::numeric_limits<int>::max());
+
+    m_colUsername = DEFAULT_USERNAME;
+    m_colEmail = DEFAULT_EMAIL;
+    m_colName = DEFAULT_NAME;
+    m_colPassword = DEFAULT_PASSWORD;
+    m_colPermissions = DEFAULT_PERMISSIONS;
+
+    qint64 line = 0;
+    bool firstRecord = true;
+    bool endOfFile = false;
+
+    // 读取一块有效行（格式错误和块内重复的行直接记为失败/跳过）
+    auto readChunk = [&](QVector<importrow> *chunk) {
+        QSet<QString> seen;
+        QStringList fields;
+        while (chunk->size() < m_chunkSize) {
+            if (!readRecord(device, &fields, &line, &summary.progress.bytesRead)) {
+                endOfFile = true;
+                return;
+            }
+            if (firstRecord) {
+                firstRecord = false;
+                if (!fields.isEmpty() && fields.first().startsWith(QChar(0xFEFF))) {
+                    fields.first().remove(0, 1);
+                }
+                if (parseHeader(fields)) {
+                    continue;
+                }
+            }
+
+            ++summary.progress.rowsRead;
+            importrow row;
+            QString error;
+            if (!parseRow(fields, line, &row, &error)) {
+                ++summary.progress.failed;
+                addError(&summary, line, fieldAt(fields, m_colUsername), error);
+                continue;
+            }
+            if (seen.contains(row.username)) {
+                ++summary.progress.skipped;
+                addError(&summary, line, row.username, "文件内用户名重复");
+                continue;
+            }
+            seen.insert(row.username);
+            chunk->append(row);
+        }
+    };
+
+    // 双缓冲：写入当前块时，后台线程池计算下一块的密码哈希
+    QVector<importrow> chunks[2];
+    QFuture<void> hashing[2];
+    auto hashRow = [](importrow &row) {
+        row.passwordHash = AuthManager::hashPassword(row.password);
+        row.password.clear();
+    };
+
+    int current = 0;
+    readChunk(&chunks[current]);
+    hashing[current] = QtConcurrent::map(chunks[current], hashRow);
+
+    while (!chunks[current].isEmpty()) {
+        const int next = 1 - current;
+        chunks[next].clear();
+        if (!endOfFile && !m_cancelled) {
+            readChunk(&chunks[next]);
+            hashing[next] = QtConcurrent::map(chunks[next], hashRow);
+        }
+
+        hashing[current].waitForFinished();
+        if (!writeChunk(conn.database(), &writer, &chunks[current], &summary)) {
+            hashing[next].waitForFinished();
+            summary.elapsedMs = timer.elapsed();
+            return summary;
+        }
+        chunks[current].clear();
+
+        if (m_progressCallback) {
+            m_progressCallback(summary.progress);
+        }
+        if (m_cancelled) {
+            hashing[next].waitForFinished();
+            summary.cancelled = true;
+            break;
+        }
+        current = next;
+    }
+
+    summary.success = !summary.cancelled;
+    summary.elapsedMs = timer.elapsed();
+    qDebug() << "批量导入结束 读取:" << summary.progress.rowsRead << "导入:" << summary.progress.imported
+             << "跳过:" << summary.progress.skipped << "失败:" << summary.progress.failed
+             << "用时(ms):" << summary.elapsedMs;
+    return summary;
+}
+
+// 读取下一条 CSV 记录：按行读取，引号未闭合时继续读入下一行
+bool userimporter::readRecord(QIODevice *device, QStringList *fields, qint64 *line, qint64 *bytesRead)
+{
+    fields->clear();
+    QString field;
+    bool inQuotes = false;
+    bool haveRecord = false;
+
+    while (!device->atEnd()) {
+        const QByteArray raw = device->readLine();
+        *bytesRead += raw.size();
+        ++*line;
+
+        QString text = QString::fromUtf8(raw);
+        if (!inQuotes) {
+            while (text.endsWith('\n') || text.endsWith('\r')) {
+                text.chop(1);
+            }
+            // 跳过记录之间的空行
+            if (!haveRecord && text.trimmed().isEmpty()) {
+                continue;
+            }
+        }
+        haveRecord = true;
+
+        for (int i = 0; i < text.size(); ++i) {
+            const QChar ch = text.at(i);
+            if (inQuotes) {
+                if (ch == '"') {
+                    if (i + 1 < text.size() && text.at(i + 1) == '"') {
+                        field += '"';
+                        ++i;
+                    } else {
+                        inQuotes = false;
+                    }
+                } else {
+                    field += ch;
+                }
+            } else if (ch == '"') {
+                inQuotes = true;
+            } else if (ch == ',') {
+                fields->append(field);
+                field.clear();
+            } else if (ch != '\r' && ch != '\n') {
+                field += ch;
+            }
+        }
+
+        if (!inQuotes) {
+            fields->append(field);
+            return true;
+        }
+    }
+
+    // 文件在引号内结束：按已读到的内容返回，由 parseRow 校验
+    if (haveRecord) {
+        fields->append(field);
+        return true;
+    }
+    return false;
+}
+
+// 首行包含 username 列时视为表头，按列名确定各列位置
+bool userimporter::parseHeader(const QStringList &fields)
+{
+    QHash<QString, int> columns;
+    for (int i = 0; i < fields.size(); ++i) {
+        columns.insert(fields.at(i).trimmed().toLower(), i);
+    }
+    if (!columns.contains("username")) {
+        return false;
+    }
+
+    m_colUsername = columns.value("username");
+    m_colEmail = columns.value("email", -1);
+    m_colName = columns.value("name", -1);
+    m_colPassword = columns.value("password", -1);
+    m_colPermissions = columns.value("permissions", -1);
+    return true;
+}
+
+// 与注册界面使用相同的校验规则，并拒绝登录界面不允许输入的中文字符
+bool userimporter::parseRow(const QStringList &fields, qint64 line, importrow *row, QString *error) const
+{
+    row->line = line;
+    row->username = fieldAt(fields, m_colUsername);
+    row->email = fieldAt(fields, m_colEmail);
+    row->name = fieldAt(fields, m_colName);
+    row->password = fieldAt(fields, m_colPassword);
+
+    if (row->username.length() < 3 || row->username.length() > 100) {
+        *error = "用户名长度必须为 3 到 100 个字符";
+        return false;
+    }
+    if (containsCjk(row->username)) {
+        *error = "用户名不能包含中文";
+        return false;
+    }
+    if (row->password.length() < 6 || row->password.length() > 18) {
+        *error = "密码长度必须为 6 到 18 个字符";
+        return false;
+    }
+    if (containsCjk(row->password)) {
+        *error = "密码不能包含中文";
+        return false;
+    }
+    if (row->email.isEmpty() || !row->email.contains('@')) {
+        *error = "邮箱格式不正确";
+        return false;
+    }
+    if (row->name.length() < 2 || row->name.length() > 10) {
+        *error = "姓名长度必须为 2 到 10 个字符";
+        return false;
+    }
+
+    const QString permissions = fieldAt(fields, m_colPermissions);
+    const QStringList parts = permissions.split(QRegularExpression("[;|\\s]+"), Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        bool ok = false;
+        const int functionId = part.toInt(&ok);
+        if (!ok || !m_functions.contains(functionId)) {
+            *error = QString("无效的功能编号: %1").arg(part);
+            return false;
+        }
+        if (!row->functions.contains(functionId)) {
+            row->functions.append(functionId);
+        }
+    }
+    return true;
+}
+
+// 查询一块用户名中已存在于数据库的部分（每条 IN 查询最多 EXISTS_BATCH 个参数）
+bool userimporter::findExisting(const QSqlDatabase &db, const QVector<importrow> &chunk,
+                                QSet<QString> *existing, QString *error) const
+{
+    for (int offset = 0; offset < chunk.size(); offset += EXISTS_BATCH) {
+        const int count = qMin(EXISTS_BATCH, int(chunk.size()) - offset);
+        QStringList placeholders;
+        for (int i = 0; i < count; ++i) {
+            placeholders << "?";
+        }
+
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.prepare(QString("SELECT username FROM NowUsers WHERE username IN (%1)").arg(placeholders.join(", ")))) {
+            *error = QString("预编译用户名查询失败: %1").arg(query.lastError().text());
+            return false;
+        }
+        for (int i = 0; i < count; ++i) {
+            query.addBindValue(chunk.at(offset + i).username);
+        }
+        if (!query.exec()) {
+            *error = QString("查询已有用户失败: %1").arg(query.lastError().text());
+            return false;
+        }
+        while (query.next()) {
+            existing->insert(query.value(0).toString());
+        }
+    }
+    return true;
+}
+
+// 写入一块：跳过数据库中已有的用户名，整块在一个事务中写入；
+// 整块失败时逐行重试，以便准确记录出错的行。只有数据库不可用时返回 false
+bool userimporter::writeChunk(const QSqlDatabase &db, userbulkwriter *writer,
+                              QVector<importrow> *chunk, importsummary *summary)
+{
+    if (chunk->isEmpty()) {
+        return true;
+    }
+
+    QSet<QString> existing;
+    QString error;
+    if (!findExisting(db, *chunk, &existing, &error)) {
+        summary->error = error;
+        return false;
+    }
+
+    QVector<const importrow*> pending;
+    pending.reserve(chunk->size());
+    for (const importrow &row : *chunk) {
+        if (existing.contains(row.username)) {
+            ++summary->progress.skipped;
+            addError(summary, row.line, row.username, "用户名已存在");
+        } else {
+            pending.append(&row);
+        }
+    }
+
+    auto toBulkUser = [](const importrow &row) {
+        bulkuser user;
+        user.username = row.username;
+        user.passwordHash = row.passwordHash;
+        user.email = row.email;
+        user.name = row.name;
+        user.enabledFunctions = row.functions;
+        return user;
+    };
+
+    for (const importrow *row : pending) {
+        writer->append(toBulkUser(*row));
+    }
+    if (writer->flush()) {
+        summary->progress.imported += pending.size();
+        return true;
+    }
+
+    qDebug() << "整块写入失败，逐行重试:" << writer->getLastError();
+    int failedRows = 0;
+    for (const importrow *row : pending) {
+        writer->append(toBulkUser(*row));
+        if (writer->flush()) {
+            ++summary->progress.imported;
+        } else {
+            ++summary->progress.failed;
+            ++failedRows;
+            addError(summary, row->line, row->username, writer->getLastError());
+        }
+    }
+
+    // 整块全部失败且连接已断开，说明是数据库问题而不是数据问题
+    if (failedRows == int(pending.size()) && !db.isOpen()) {
+        summary->error = writer->getLastError();
+        return false;
+    }
+    return true;
+}
+
+void userimporter::addError(importsummary *summary, qint64 line, const QString &username, const QString &message) const
+{
+    if (summary->errors.size() < m_maxErrors) {
+        importerror error;
+        error.line = line;
+        error.username = username;
+        error.message = message;
+        summary->errors.append(error);
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef USERIMPORTER_H
+#define USERIMPORTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+#include <QSet>
+#include <atomic>
+#include <functional>
+#include "../database/functioncatalog.h"
+
+class databasemanager;
+class userbulkwriter;
+class QIODevice;
+class QSqlDatabase;
+
+// 导入失败的一行
+struct importerror
+{
+    qint64 line = 0;        // CSV 中的行号（从 1 开始，含表头）
+    QString username;
+    QString message;
+};
+
+// 导入进度（每写完一批回调一次）
+struct importprogress
+{
+    qint64 rowsRead = 0;     // 已读取的数据行
+    qint64 imported = 0;     // 已写入的用户
+    qint64 skipped = 0;      // 因用户名已存在（数据库中或文件内重复）跳过
+    qint64 failed = 0;       // 格式错误或写入失败
+    qint64 bytesRead = 0;
+    qint64 bytesTotal = 0;   // 未知时为 0
+};
+
+// 导入结果
+struct importsummary
+{
+    bool success = false;    // 整个过程是否正常结束（单行失败不影响）
+    bool cancelled = false;
+    QString error;           // 整体失败原因（如文件无法打开、数据库未连接）
+    importprogress progress;
+    QList<importerror> errors;  // 单行错误（最多保留 maxErrors 条，计数见 progress.failed / skipped）
+    qint64 elapsedMs = 0;
+};
+
+// 批量导入用户（CSV：username,email,name,password,permissions）
+// 按块流式读取，密码哈希在线程池中并行计算，块内用户名一次性与数据库比对去重，
+// 通过 userbulkwriter 用 execBatch 分块事务写入；下一块的哈希与本块的写入重叠进行，内存中最多两块
+// permissions 列为以 ; 或 | 分隔的功能编号（如 1;3;5，必须在功能目录中），可为空；有表头时按表头列名匹配列
+class userimporter
+{
+public:
+    explicit userimporter(databasemanager *dbManager);
+
+    // 每块的行数（默认 5000，同时也是每个事务写入的用户数）
+    void setChunkSize(int rows);
+
+    // 保留的单行错误上限（默认 1000）
+    void setMaxErrors(int count);
+
+    // 进度回调（在执行导入的线程中调用）
+    void setProgressCallback(const std::function<void(const importprogress &)> &callback);
+
+    // 请求取消（线程安全），当前块写完后停止
+    void cancel();
+
+    // 从文件或设备导入，在调用线程中执行（耗时操作，界面中应在后台线程调用）
+    importsummary importFile(const QString &path);
+    importsummary importDevice(QIODevice *device, qint64 bytesTotal = 0);
+
+private:
+    struct importrow
+    {
+        qint64 line = 0;
+        QString username;
+        QString email;
+        QString name;
+        QString password;
+        QString passwordHash;
+        QList<int> functions;
+    };
+
+    // 读取下一条 CSV 记录（支持引号内的逗号、引号转义与换行），文件结束返回 false
+    static bool readRecord(QIODevice *device, QStringList *fields, qint64 *line, qint64 *bytesRead);
+
+    // 首行为表头时记录各列位置并返回 true
+    bool parseHeader(const QStringList &fields);
+
+    // 把一条记录转换为导入行，格式错误时返回 false 并写入 error
+    bool parseRow(const QStringList &fields, qint64 line, importrow *row, QString *error) const;
+
+    // 查询一块中已存在于数据库的用户名
+    bool findExisting(const QSqlDatabase &db, const QVector<importrow> &chunk,
+                      QSet<QString> *existing, QString *error) const;
+
+    // 去重后写入一块，数据库不可用时返回 false
+    bool writeChunk(const QSqlDatabase &db, userbulkwriter *writer,
+                    QVector<importrow> *chunk, importsummary *summary);
+
+    void addError(importsummary *summary, qint64 line, const QString &username, const QString &message) const;
+
+    databasemanager *m_dbManager;
+    int m_chunkSize;
+    int m_maxErrors;
+    std::function<void(const importprogress &)> m_progressCallback;
+    std::atomic<bool> m_cancelled;
+
+    // 列索引（由表头决定，默认 username,email,name,password,permissions）
+    int m_colUsername;
+    int m_colEmail;
+    int m_colName;
+    int m_colPassword;
+    int m_colPermissions;
+
+    // 功能目录（每次导入开始时取得，用于校验 permissions 列）
+    functioncatalog m_functions;
+};
+
+#endif // USERIMPORTER_H
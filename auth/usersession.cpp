@@ -0,0 +1,21 @@
+#include "usersession.h"
+
+bool usersession::isValid() const
+{
+    return userId > 0;
+}
+
+bool usersession::isAdmin() const
+{
+    return roleType == 1;
+}
+
+bool usersession::hasPermission(int functionId) const
+{
+    return functionregistry::has(permissions, functionId);
+}
+
+QList<int> usersession::permissionList() const
+{
+    return functionregistry::toList(permissions);
+}
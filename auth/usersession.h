@@ -0,0 +1,28 @@
+#ifndef USERSESSION_H
+#define USERSESSION_H
+#include <QString>
+#include <QList>
+#include "functionregistry.h"
+
+// 登录会话：登录成功后一次性取得的身份、角色与功能权限
+struct usersession
+{
+    int userId = -1;
+    QString username;
+    int roleType = 2;           // 1 = 管理员，2 = 普通用户
+    permmask permissions = 0;   // 已启用功能的位掩码（见 functionregistry）
+
+    // 会话是否有效（已登录）
+    bool isValid() const;
+
+    // 是否是管理员
+    bool isAdmin() const;
+
+    // 是否拥有指定功能的权限（一次位运算）
+    bool hasPermission(int functionId) const;
+
+    // 已启用的功能 function_id 列表
+    QList<int> permissionList() const;
+};
+
+#endif // USERSESSION_H
@@ -0,0 +1,392 @@
+#include "authbenchmark.h"
+#include "../config/configmanager.h"
+#include "../database/databasemanager.h"
+#include "../auth/authmanager.h"
+#include "../auth/functionregistry.h"
+#include "../widgets/permissionmanagementwidget.h"
+#include "../widgets/loginwidget.h"
+#include "../widgets/registerwidget.h"
+#include "../widgets/maincontentwidget.h"
+#include "../widgets/apptheme.h"
+
+#include <QtTest>
+#include <QApplication>
+#include <QTableView>
+#include <QElapsedTimer>
+
+//一个已写入种子数据的数据库及其连接
+struct authbenchmark::fixture
+{
+    explicit fixture(benchdatabase::storage mode)
+        : data(mode)
+    {
+    }
+
+    benchdatabase data;
+    configmanager config;
+    std::unique_ptr<databasemanager> dbManager;
+    std::unique_ptr<AuthManager> authManager;
+    int users = 0;
+    qint64 seedMs = 0;
+};
+
+namespace {
+
+enum page
+{
+    loginpage,
+    registerpage,
+    mainpage
+};
+
+QString storageName(benchdatabase::storage mode)
+{
+    return mode == benchdatabase::inmemory ? "memory" : "disk";
+}
+
+QString profileName(benchdatabase::profile profile)
+{
+    return profile == benchdatabase::defaultprofile ? "default" : "tuned";
+}
+
+//构造并显示一个页面；appStyle 为 false 时模拟旧做法，页面各自 setStyleSheet
+template <typename Page>
+void showPage(bool appStyle)
+{
+    Page page;
+    if (!appStyle) {
+        page.setStyleSheet(AppTheme::styleSheet());
+    }
+    page.resize(880, 640);
+    page.show();
+    QApplication::processEvents();
+}
+
+}
+
+authbenchmark::authbenchmark(const benchmatrix &matrix, QObject *parent)
+    : QObject(parent)
+    , m_matrix(matrix)
+    , m_random(20240601)
+    , m_registerSerial(0)
+{
+}
+
+authbenchmark::~authbenchmark()
+{
+}
+
+void authbenchmark::cleanupTestCase()
+{
+    m_fixtures.clear();
+}
+
+void authbenchmark::addDatabaseRows()
+{
+    QTest::addColumn<int>("users");
+    QTest::addColumn<int>("storage");
+    QTest::addColumn<int>("profile");
+    for (benchdatabase::storage mode : m_matrix.storages) {
+        for (benchdatabase::profile profile : m_matrix.profiles) {
+            for (int users : m_matrix.sizes) {
+                const QString tag = QString("%1/%2/%3").arg(users).arg(storageName(mode), profileName(profile));
+                QTest::newRow(tag.toUtf8().constData()) << users << int(mode) << int(profile);
+            }
+        }
+    }
+}
+
+//当前行的数据库：同一组合只写入一次种子数据
+authbenchmark::fixture *authbenchmark::currentFixture(QString *error)
+{
+    const QString tag = QString::fromUtf8(QTest::currentDataTag());
+    auto it = m_fixtures.find(tag);
+    if (it != m_fixtures.end()) {
+        return it->second.get();
+    }
+
+    QFETCH(int, users);
+    QFETCH(int, storage);
+    QFETCH(int, profile);
+
+    std::unique_ptr<fixture> created(new fixture(benchdatabase::storage(storage)));
+    if (!created->data.isValid()) {
+        *error = "无法创建临时目录";
+        return nullptr;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    if (!created->data.seed(users)) {
+        *error = created->data.getLastError();
+        return nullptr;
+    }
+    created->seedMs = timer.elapsed();
+    created->users = users;
+
+    if (!created->data.configure(&created->config, benchdatabase::profile(profile))) {
+        *error = created->data.getLastError();
+        return nullptr;
+    }
+    created->dbManager.reset(new databasemanager(&created->config));
+    if (!created->dbManager->connectDatabase()) {
+        *error = created->dbManager->getLastError();
+        return nullptr;
+    }
+    created->authManager.reset(new AuthManager(created->dbManager.get()));
+
+    fixture *result = created.get();
+    m_fixtures[tag] = std::move(created);
+    return result;
+}
+
+#define FETCH_FIXTURE(name)                                  \
+    QString fixtureError;                                    \
+    fixture *name = currentFixture(&fixtureError);           \
+    QVERIFY2(name, qPrintable(fixtureError))
+
+void authbenchmark::seed_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::seed()
+{
+    FETCH_FIXTURE(data);
+    // 种子数据在首次使用该组合时写入，这里只报告当时的总耗时
+    QTest::setBenchmarkResult(qreal(data->seedMs), QTest::WalltimeMilliseconds);
+}
+
+void authbenchmark::login_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::login()
+{
+    FETCH_FIXTURE(data);
+    bool ok = true;
+    QBENCHMARK {
+        const int index = 1 + m_random.bounded(data->users);
+        ok = data->authManager->login(benchdatabase::username(index), benchdatabase::password()) && ok;
+    }
+    QVERIFY2(ok, qPrintable(data->authManager->getLastError()));
+}
+
+void authbenchmark::userExists_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::userExists()
+{
+    FETCH_FIXTURE(data);
+    // 一半查询存在的用户，一半查询不存在的用户
+    bool ok = true;
+    int i = 0;
+    QBENCHMARK {
+        const int index = 1 + m_random.bounded(data->users);
+        const bool expected = (i++ % 2 == 0);
+        const QString username = expected ? benchdatabase::username(index) : QString("absent%1").arg(index);
+        ok = (data->authManager->userExists(username) == expected) && ok;
+    }
+    QVERIFY(ok);
+}
+
+void authbenchmark::registerUser_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::registerUser()
+{
+    FETCH_FIXTURE(data);
+    bool ok = true;
+    QBENCHMARK {
+        userinfodata newUser;
+        newUser.username = QString("newuser%1").arg(++m_registerSerial, 7, 10, QChar('0'));
+        newUser.password = benchdatabase::password();
+        newUser.email = newUser.username + "@example.com";
+        newUser.name = newUser.username;
+        userinfo user;
+        user.setUserData(newUser);
+        ok = data->authManager->registerUser(user) && ok;
+    }
+    QVERIFY2(ok, qPrintable(data->authManager->getLastError()));
+}
+
+void authbenchmark::getUserFunctionPermissions_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::getUserFunctionPermissions()
+{
+    FETCH_FIXTURE(data);
+    // 随机用户：未缓存时一次按用户名的索引查询读出 perm_mask，之后命中权限缓存
+    QBENCHMARK {
+        const int index = 1 + m_random.bounded(data->users);
+        data->authManager->getUserFunctionPermissions(benchdatabase::username(index));
+    }
+}
+
+void authbenchmark::hasFunctionPermission_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::hasFunctionPermission()
+{
+    FETCH_FIXTURE(data);
+    QBENCHMARK {
+        const int index = 1 + m_random.bounded(data->users);
+        const int functionId = functionregistry::FUNCTIONS[m_random.bounded(functionregistry::COUNT)].id;
+        data->authManager->hasFunctionPermission(benchdatabase::username(index), functionId);
+    }
+}
+
+void authbenchmark::getAllUsers_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::getAllUsers()
+{
+    FETCH_FIXTURE(data);
+    int count = 0;
+    QBENCHMARK {
+        count = data->authManager->getAllUsers().size();
+    }
+    QVERIFY(count > 0);
+}
+
+void authbenchmark::getUsersPage_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::getUsersPage()
+{
+    FETCH_FIXTURE(data);
+    // 从随机位置开始取一页（键集分页的代价与起点无关）
+    bool ok = true;
+    QBENCHMARK {
+        const QString after = benchdatabase::username(m_random.bounded(data->users));
+        ok = data->authManager->getUsersPage(after).success && ok;
+    }
+    QVERIFY(ok);
+}
+
+void authbenchmark::forEachUser_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::forEachUser()
+{
+    FETCH_FIXTURE(data);
+    bool ok = true;
+    qint64 count = 0;
+    QBENCHMARK {
+        count = 0;
+        ok = data->authManager->forEachUser([&count](const userinfodata &) {
+            ++count;
+            return true;
+        }) && ok;
+    }
+    QVERIFY(ok && count > 0);
+}
+
+void authbenchmark::initUserTable_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::initUserTable()
+{
+    FETCH_FIXTURE(data);
+    // 结构已是最新版本：只执行一次版本查询
+    bool ok = true;
+    QBENCHMARK {
+        ok = data->dbManager->initUserTable() && ok;
+    }
+    QVERIFY2(ok, qPrintable(data->dbManager->getLastError()));
+}
+
+void authbenchmark::savePermissionChanges_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::savePermissionChanges()
+{
+    FETCH_FIXTURE(data);
+    // 每次保存 100 个随机单元格的修改
+    bool ok = true;
+    QBENCHMARK {
+        QList<permissionchange> changes;
+        for (int i = 0; i < 100; ++i) {
+            permissionchange change;
+            change.userId = 1 + m_random.bounded(data->users);
+            change.functionId = functionregistry::FUNCTIONS[m_random.bounded(functionregistry::COUNT)].id;
+            change.enabled = m_random.bounded(2) == 1;
+            changes.append(change);
+        }
+        ok = data->authManager->savePermissionChanges(changes) && ok;
+    }
+    QVERIFY2(ok, qPrintable(data->authManager->getLastError()));
+}
+
+void authbenchmark::permissionDialogOpen_data()
+{
+    addDatabaseRows();
+}
+
+void authbenchmark::permissionDialogOpen()
+{
+    FETCH_FIXTURE(data);
+    // 构造、显示到用户列表在后台加载完成（表格重新启用）
+    QBENCHMARK_ONCE {
+        PermissionManagementWidget dialog(data->authManager.get());
+        dialog.show();
+        QTableView *table = dialog.findChild<QTableView *>();
+        QVERIFY(table);
+        QTRY_VERIFY_WITH_TIMEOUT(table->isEnabled(), 600000);
+        dialog.close();
+    }
+}
+
+void authbenchmark::widget_construction_data()
+{
+    QTest::addColumn<int>("page");
+    QTest::addColumn<bool>("appStyle");
+    const bool modes[] = {false, true};
+    for (bool appStyle : modes) {
+        const char *style = appStyle ? "style=app" : "style=widget";
+        QTest::newRow(qPrintable(QString("login/%1").arg(style))) << int(loginpage) << appStyle;
+        QTest::newRow(qPrintable(QString("register/%1").arg(style))) << int(registerpage) << appStyle;
+        QTest::newRow(qPrintable(QString("main/%1").arg(style))) << int(mainpage) << appStyle;
+    }
+}
+
+void authbenchmark::widget_construction()
+{
+    QFETCH(int, page);
+    QFETCH(bool, appStyle);
+
+    // 应用级样式表（AppTheme::apply 的做法）与每个页面各自 setStyleSheet 的旧做法对比
+    qApp->setStyleSheet(appStyle ? AppTheme::styleSheet() : QString());
+    QBENCHMARK {
+        switch (page) {
+        case loginpage:
+            showPage<LoginWidget>(appStyle);
+            break;
+        case registerpage:
+            showPage<RegisterWidget>(appStyle);
+            break;
+        default:
+            showPage<MainContentWidget>(appStyle);
+            break;
+        }
+    }
+    qApp->setStyleSheet(QString());
+}
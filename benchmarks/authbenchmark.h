@@ -0,0 +1,80 @@
+#ifndef AUTHBENCHMARK_H
+#define AUTHBENCHMARK_H
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QRandomGenerator>
+#include <map>
+#include <memory>
+#include "benchdata.h"
+
+//基准测试的数据规模、存储方式与 SQLite 连接参数（每个组合是 _data() 中的一行）
+struct benchmatrix
+{
+    QList<int> sizes = QList<int>() << 1000 << 100000 << 1000000;
+    QList<benchdatabase::storage> storages = QList<benchdatabase::storage>() << benchdatabase::ondisk << benchdatabase::inmemory;
+    QList<benchdatabase::profile> profiles = QList<benchdatabase::profile>() << benchdatabase::defaultprofile << benchdatabase::tunedprofile;
+};
+
+//AuthManager 与 databasemanager 的 QBENCHMARK 用例
+//数据库用例按 benchmatrix 的每个组合各执行一行（标签为 用户数/存储方式/连接参数，如 1000/disk/tuned），
+//每个组合只写入一次种子数据，在全部用例间共享
+class authbenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit authbenchmark(const benchmatrix &matrix, QObject *parent = nullptr);
+    ~authbenchmark() override;
+
+private slots:
+    void cleanupTestCase();
+
+    //写入种子数据的耗时（只执行一次，结果为总耗时）
+    void seed_data();
+    void seed();
+
+    void login_data();
+    void login();
+    void userExists_data();
+    void userExists();
+    void registerUser_data();
+    void registerUser();
+    void getUserFunctionPermissions_data();
+    void getUserFunctionPermissions();
+    void hasFunctionPermission_data();
+    void hasFunctionPermission();
+    void getAllUsers_data();
+    void getAllUsers();
+    void getUsersPage_data();
+    void getUsersPage();
+    void forEachUser_data();
+    void forEachUser();
+    void initUserTable_data();
+    void initUserTable();
+    void savePermissionChanges_data();
+    void savePermissionChanges();
+    void permissionDialogOpen_data();
+    void permissionDialogOpen();
+
+    //页面构造到首次显示完成（含样式解析与布局），与数据库无关
+    //行标签为 页面/style=widget（每个页面各自 setStyleSheet 的旧做法）或 页面/style=app（应用级样式表）
+    void widget_construction_data();
+    void widget_construction();
+
+private:
+    struct fixture;
+
+    //为数据库用例添加 benchmatrix 中的全部行
+    void addDatabaseRows();
+
+    //当前行对应的已写入种子数据的数据库（首次使用时创建），失败时返回 nullptr 并写入 error
+    fixture *currentFixture(QString *error);
+
+    benchmatrix m_matrix;
+    std::map<QString, std::unique_ptr<fixture>> m_fixtures;   // 行标签 -> 数据库
+    QRandomGenerator m_random;
+    int m_registerSerial;   // registerUser 用例的用户名序号
+};
+
+#endif // AUTHBENCHMARK_H
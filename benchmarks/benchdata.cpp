@@ -0,0 +1,161 @@
+#include "benchdata.h"
+#include "../config/configmanager.h"
+#include "../database/databasemanager.h"
+#include "../database/userbulkwriter.h"
+#include "../auth/functionregistry.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSettings>
+#include <QRandomGenerator>
+#include <QCryptographicHash>
+#include <QAtomicInt>
+#include <QDebug>
+
+namespace {
+// 每个实例使用不同的连接名与内存数据库名
+QAtomicInt nextBenchSerial(0);
+}
+
+benchdatabase::benchdatabase(storage mode)
+    : m_mode(mode)
+    , m_connectionName(QString("learn1_bench_seed_%1").arg(nextBenchSerial.fetchAndAddRelaxed(1) + 1))
+    , m_lastError("")
+{
+}
+
+benchdatabase::~benchdatabase()
+{
+    if (QSqlDatabase::contains(m_connectionName)) {
+        {
+            QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(m_connectionName);
+    }
+}
+
+bool benchdatabase::isValid() const
+{
+    return m_dir.isValid();
+}
+
+QString benchdatabase::databasePath() const
+{
+    if (m_mode == inmemory) {
+        return QString("file:%1?mode=memory&cache=shared").arg(m_connectionName);
+    }
+    return m_dir.path() + "/learn1.db";
+}
+
+QString benchdatabase::storageName() const
+{
+    return m_mode == inmemory ? "memory" : "disk";
+}
+
+QString benchdatabase::username(int index)
+{
+    return QString("user%1").arg(index, 7, 10, QChar('0'));
+}
+
+QString benchdatabase::password()
+{
+    return "bench123";
+}
+
+//通过结构迁移创建表结构，再用批量写入器写入测试用户
+bool benchdatabase::seed(int userCount)
+{
+    // 内存数据库在最后一个连接关闭时释放，先打开一个连接保持到对象销毁
+    if (m_mode == inmemory) {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+        db.setDatabaseName(databasePath());
+        db.setConnectOptions("QSQLITE_OPEN_URI");
+        if (!db.open()) {
+            m_lastError = db.lastError().text();
+            return false;
+        }
+    }
+
+    configmanager config;
+    if (!configure(&config, tunedprofile)) {
+        return false;
+    }
+    databasemanager dbManager(&config);
+    if (!dbManager.connectDatabase() || !dbManager.migrateSchema()) {
+        m_lastError = dbManager.getLastError();
+        return false;
+    }
+
+    connectionguard conn(dbManager.getConnectionPool());
+    if (!conn.isValid()) {
+        m_lastError = "数据库未连接";
+        return false;
+    }
+    {
+        // 种子数据可重建，写入时不等待落盘
+        QSqlQuery query(conn.database());
+        query.exec("PRAGMA synchronous = OFF");
+    }
+
+    // 所有用户使用同一个密码哈希，避免哈希计算影响写入速度
+    const QString passwordHash = QCryptographicHash::hash(password().toUtf8(), QCryptographicHash::Md5).toHex();
+    QRandomGenerator random(20240601);
+
+    userbulkwriter writer(conn.database());
+    for (int i = 1; i <= userCount; ++i) {
+        bulkuser user;
+        user.username = username(i);
+        user.passwordHash = passwordHash;
+        user.email = user.username + "@example.com";
+        user.name = user.username;
+        // 每个功能以 50% 概率启用
+        for (const functiondef &function : functionregistry::FUNCTIONS) {
+            if (random.bounded(2)) {
+                user.enabledFunctions << function.id;
+            }
+        }
+        if (!writer.append(user)) {
+            m_lastError = writer.getLastError();
+            return false;
+        }
+    }
+    if (!writer.flush()) {
+        m_lastError = writer.getLastError();
+        return false;
+    }
+    return true;
+}
+
+//生成配置文件并初始化配置管理器
+bool benchdatabase::configure(configmanager *config, profile connectionProfile)
+{
+    const QString iniPath = m_dir.path() + "/config.ini";
+    {
+        QSettings settings(iniPath, QSettings::IniFormat);
+        settings.clear();
+        settings.beginGroup("Database");
+        settings.setValue("Type", "SQLITE");
+        settings.setValue("DatabaseName", databasePath());
+        if (connectionProfile == defaultprofile) {
+            // 与不设置任何 PRAGMA 的连接一致，作为对照组
+            settings.setValue("JournalMode", "DELETE");
+            settings.setValue("Synchronous", "FULL");
+            settings.setValue("MmapSize", "0");
+            settings.setValue("CacheSize", "-2000");
+        }
+        settings.endGroup();
+        settings.sync();
+    }
+
+    if (!config->initConfigManager(iniPath)) {
+        m_lastError = "配置管理器初始化失败";
+        return false;
+    }
+    return true;
+}
+
+QString benchdatabase::getLastError() const
+{
+    return m_lastError;
+}
@@ -0,0 +1,58 @@
+#ifndef BENCHDATA_H
+#define BENCHDATA_H
+#include <QString>
+#include <QTemporaryDir>
+
+class configmanager;
+
+//基准测试用的临时 SQLite 数据库（磁盘文件或共享内存）
+class benchdatabase
+{
+public:
+    enum storage
+    {
+        ondisk,     // 临时目录中的数据库文件
+        inmemory    // 共享缓存的内存数据库（file:...?mode=memory&cache=shared）
+    };
+
+    explicit benchdatabase(storage mode = ondisk);
+    ~benchdatabase();
+
+    //临时目录是否可用
+    bool isValid() const;
+
+    //数据库文件路径或 URI
+    QString databasePath() const;
+
+    //存储方式名称（disk / memory）
+    QString storageName() const;
+
+    //通过结构迁移创建表结构，并批量写入 userCount 个用户（每个功能以 50% 概率启用）
+    bool seed(int userCount);
+
+    //SQLite 连接参数
+    enum profile
+    {
+        defaultprofile,   // SQLite 默认值（DELETE 日志、synchronous=FULL、不使用 mmap、2 MB 缓存）
+        tunedprofile      // config.ini 的默认配置（WAL、synchronous=NORMAL、mmap、64 MB 缓存）
+    };
+
+    //生成指向该数据库的配置文件，并初始化配置管理器
+    bool configure(configmanager *config, profile connectionProfile = tunedprofile);
+
+    //种子数据中用户的用户名与明文密码
+    static QString username(int index);
+    static QString password();
+
+    QString getLastError() const;
+
+private:
+    Q_DISABLE_COPY(benchdatabase)
+
+    storage m_mode;
+    QTemporaryDir m_dir;
+    QString m_connectionName;   // 内存数据库的保持连接；内存数据库在最后一个连接关闭时释放
+    QString m_lastError;
+};
+
+#endif // BENCHDATA_H
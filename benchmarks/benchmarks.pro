@@ -0,0 +1,41 @@
+# 性能基准测试（QtTest 的 QBENCHMARK 用例，无界面，使用 offscreen 平台与 SQLite）
+QT       += core gui sql concurrent widgets testlib
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = learn1_bench
+
+include(../core.pri)
+
+# 页面头文件按工程根目录引用（如 auth/userinfo.h）
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    main.cpp \
+    benchdata.cpp \
+    authbenchmark.cpp \
+    benchreport.cpp \
+    ../widgets/permissionmanagementwidget.cpp \
+    ../widgets/permissionmatrixmodel.cpp \
+    ../widgets/permissioncheckdelegate.cpp \
+    ../widgets/loginwidget.cpp \
+    ../widgets/registerwidget.cpp \
+    ../widgets/maincontentwidget.cpp \
+    ../widgets/backgroundimagecache.cpp \
+    ../widgets/apptheme.cpp \
+    ../metrics/rendermetrics.cpp
+
+HEADERS += \
+    benchdata.h \
+    authbenchmark.h \
+    benchreport.h \
+    ../widgets/permissionmanagementwidget.h \
+    ../widgets/permissionmatrixmodel.h \
+    ../widgets/permissioncheckdelegate.h \
+    ../widgets/loginwidget.h \
+    ../widgets/registerwidget.h \
+    ../widgets/maincontentwidget.h \
+    ../widgets/backgroundimagecache.h \
+    ../widgets/apptheme.h \
+    ../metrics/rendermetrics.h
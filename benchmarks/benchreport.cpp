@@ -0,0 +1,103 @@
+#include "benchreport.h"
+#include <QFile>
+#include <QXmlStreamReader>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QDateTime>
+#include <QSysInfo>
+#include <QStringList>
+
+namespace {
+//数据库用例的标签为 用户数/存储方式/连接参数（如 1000/disk/tuned）
+void addTagFields(QJsonObject *object, const QString &tag)
+{
+    (*object)["tag"] = tag;
+    const QStringList parts = tag.split('/');
+    bool numeric = false;
+    const int users = parts.value(0).toInt(&numeric);
+    if (parts.size() == 3 && numeric) {
+        (*object)["users"] = users;
+        (*object)["storage"] = parts.at(1);
+        (*object)["profile"] = parts.at(2);
+    }
+}
+}
+
+bool benchreport::writeJson(const QString &xmlPath, const QString &path, QString *error)
+{
+    QFile xmlFile(xmlPath);
+    if (!xmlFile.open(QIODevice::ReadOnly)) {
+        *error = QString("读取测试输出失败: %1").arg(xmlFile.errorString());
+        return false;
+    }
+
+    QJsonArray results;
+    QJsonArray failures;
+    QString function;
+    QXmlStreamReader xml(&xmlFile);
+    while (!xml.atEnd()) {
+        if (!xml.readNextStartElement()) {
+            continue;
+        }
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("TestFunction")) {
+            function = attributes.value("name").toString();
+        } else if (xml.name() == QLatin1String("BenchmarkResult")) {
+            // value 为单次迭代的数值
+            QJsonObject result;
+            result["case"] = function;
+            addTagFields(&result, attributes.value("tag").toString());
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toDouble();
+            result["iterations"] = attributes.value("iterations").toInt();
+            results.append(result);
+        } else if (xml.name() == QLatin1String("Incident")) {
+            const QString type = attributes.value("type").toString();
+            if (type == QLatin1String("fail") || type == QLatin1String("xpass")) {
+                QJsonObject failure;
+                failure["case"] = function;
+                failure["file"] = attributes.value("file").toString();
+                failure["line"] = attributes.value("line").toInt();
+                // 标签与描述是 Incident 的子元素
+                while (xml.readNextStartElement()) {
+                    if (xml.name() == QLatin1String("DataTag")) {
+                        addTagFields(&failure, xml.readElementText());
+                    } else if (xml.name() == QLatin1String("Description")) {
+                        failure["message"] = xml.readElementText();
+                    } else {
+                        xml.skipCurrentElement();
+                    }
+                }
+                failures.append(failure);
+            }
+        }
+    }
+    if (xml.hasError()) {
+        *error = QString("解析测试输出失败: %1").arg(xml.errorString());
+        return false;
+    }
+
+    QJsonObject root;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["qt_version"] = QString(qVersion());
+    root["host"] = QSysInfo::machineHostName();
+    root["cpu"] = QSysInfo::currentCpuArchitecture();
+    root["results"] = results;
+    root["failures"] = failures;
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    QFile file;
+    bool opened = false;
+    if (path == "-") {
+        opened = file.open(stdout, QIODevice::WriteOnly);
+    } else {
+        file.setFileName(path);
+        opened = file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!opened || file.write(json) != json.size()) {
+        *error = QString("写入 JSON 结果失败: %1").arg(file.errorString());
+        return false;
+    }
+    return true;
+}
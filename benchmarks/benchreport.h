@@ -0,0 +1,15 @@
+#ifndef BENCHREPORT_H
+#define BENCHREPORT_H
+#include <QString>
+
+//把 QTest 的 XML 输出（-o 文件,xml）转换为便于跨版本比较的 JSON
+//每个 BenchmarkResult 一项：用例名、行标签（数据库用例再拆分为 users/storage/profile）、指标、单次数值与迭代次数；
+//失败的用例记录在 failures 中
+class benchreport
+{
+public:
+    //path 为 "-" 时写到标准输出
+    static bool writeJson(const QString &xmlPath, const QString &path, QString *error);
+};
+
+#endif // BENCHREPORT_H
@@ -0,0 +1,84 @@
+#include "authbenchmark.h"
+#include "benchreport.h"
+
+#include <QApplication>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QDebug>
+
+//用法：learn1_bench [--sizes 1000,100000,1000000] [--storage disk,memory] [--sqlite-profile default,tuned]
+//                   [--json results.json|-] [QTest 参数，如 login getUsersPage:1000/disk/tuned -iterations 100]
+//      在 offscreen 平台下运行，无需显示器与外部数据库服务；--json 输出便于跨版本比较
+//      本程序的选项在前三项中解析，其余参数原样交给 QTest（可按用例名与行标签选择要执行的用例）
+
+namespace {
+
+//取出 --name value 或 --name=value 形式的选项，并从参数列表中移除
+QString takeOption(QStringList *arguments, const QString &name, const QString &defaultValue)
+{
+    const QString option = "--" + name;
+    for (int i = 1; i < arguments->size(); ++i) {
+        const QString argument = arguments->at(i);
+        if (argument == option && i + 1 < arguments->size()) {
+            const QString value = arguments->at(i + 1);
+            arguments->erase(arguments->begin() + i, arguments->begin() + i + 2);
+            return value;
+        }
+        if (argument.startsWith(option + "=")) {
+            arguments->removeAt(i);
+            return argument.mid(option.size() + 1);
+        }
+    }
+    return defaultValue;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    // 默认使用 offscreen 平台，便于在无显示环境运行
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QStringList arguments = app.arguments();
+    benchmatrix matrix;
+    matrix.sizes.clear();
+    const QStringList sizes = takeOption(&arguments, "sizes", "1000,100000,1000000").split(',', Qt::SkipEmptyParts);
+    for (const QString &size : sizes) {
+        if (size.trimmed().toInt() > 0) {
+            matrix.sizes << size.trimmed().toInt();
+        }
+    }
+    matrix.storages.clear();
+    const QStringList storages = takeOption(&arguments, "storage", "disk,memory").split(',', Qt::SkipEmptyParts);
+    for (const QString &storage : storages) {
+        matrix.storages << (storage.trimmed() == "memory" ? benchdatabase::inmemory : benchdatabase::ondisk);
+    }
+    matrix.profiles.clear();
+    const QStringList profiles = takeOption(&arguments, "sqlite-profile", "default,tuned").split(',', Qt::SkipEmptyParts);
+    for (const QString &profile : profiles) {
+        matrix.profiles << (profile.trimmed() == "default" ? benchdatabase::defaultprofile : benchdatabase::tunedprofile);
+    }
+    const QString jsonPath = takeOption(&arguments, "json", QString());
+
+    // 需要 JSON 时额外输出一份 QTest XML，结束后转换；控制台仍输出文本结果
+    QTemporaryDir reportDir;
+    const QString xmlPath = reportDir.path() + "/results.xml";
+    if (!jsonPath.isEmpty()) {
+        arguments << "-o" << xmlPath + ",xml" << "-o" << "-,txt";
+    }
+
+    authbenchmark benchmark(matrix);
+    const int failures = QTest::qExec(&benchmark, arguments);
+
+    if (!jsonPath.isEmpty()) {
+        QString error;
+        if (!benchreport::writeJson(xmlPath, jsonPath, &error)) {
+            qWarning() << error;
+            return 1;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
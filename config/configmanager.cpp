@@ -4,6 +4,8 @@
 
 configmanager::configmanager()
    : m_settings(nullptr)
+   , m_prewarmPages(true)
+   , m_prewarmDelay(500)
 {
     QString configPath = getConfigPath();
     if (!configPath.isEmpty()) {
@@ -56,6 +58,8 @@ bool configmanager::initConfigManager(const QString &configPath){
     //加载配置文件数据
     loadLogPath();
     loadDatabase();
+    loadPool();
+    loadUi();
     loadSubsysPath();
 
     return true;
@@ -81,6 +85,20 @@ bool configmanager::loadDatabase() {
         m_settings->endGroup();
         return true;
     }
+    else if(m_dbType.toLower() == "sqlite" || m_dbType.toLower() == "qsqlite"){
+        // SQLite 只需要数据库文件路径（也可以是 file:xxx?mode=memory&cache=shared 形式的 URI）
+        m_dbConfig["DatabaseName"] = m_settings->value("DatabaseName", "learn1.db").toString();
+        // 连接参数（每个连接建立后执行 PRAGMA），默认值为面向生产的 WAL 配置
+        m_dbConfig["JournalMode"] = m_settings->value("JournalMode", "WAL").toString();
+        m_dbConfig["Synchronous"] = m_settings->value("Synchronous", "NORMAL").toString();
+        m_dbConfig["MmapSize"] = m_settings->value("MmapSize", "268435456").toString();
+        m_dbConfig["CacheSize"] = m_settings->value("CacheSize", "-65536").toString();
+        m_dbConfig["BusyTimeout"] = m_settings->value("BusyTimeout", "5000").toString();
+        m_dbConfig["SharedCache"] = m_settings->value("SharedCache", "false").toString();
+        m_dbConfig["ForeignKeys"] = m_settings->value("ForeignKeys", "true").toString();
+        m_settings->endGroup();
+        return true;
+    }
     else{
         qDebug() << "Fail to config the Database!";
         m_settings->endGroup();
@@ -89,6 +107,29 @@ bool configmanager::loadDatabase() {
   
 }
 
+//连接池与连接重试配置（与数据库类型无关，同样位于 [Database] 段）
+void configmanager::loadPool() {
+    m_settings->beginGroup("Database");
+    m_poolConfig["PoolMinSize"] = m_settings->value("PoolMinSize", "1").toString();
+    m_poolConfig["PoolMaxSize"] = m_settings->value("PoolMaxSize", "8").toString();
+    m_poolConfig["PoolIdleTimeout"] = m_settings->value("PoolIdleTimeout", "300").toString();
+    m_poolConfig["PoolBorrowTimeout"] = m_settings->value("PoolBorrowTimeout", "5000").toString();
+    m_poolConfig["PoolValidateOnBorrow"] = m_settings->value("PoolValidateOnBorrow", "true").toString();
+    m_poolConfig["PoolValidateIdle"] = m_settings->value("PoolValidateIdle", "30").toString();
+    m_poolConfig["ConnectTimeout"] = m_settings->value("ConnectTimeout", "5").toString();
+    m_poolConfig["ConnectRetries"] = m_settings->value("ConnectRetries", "3").toString();
+    m_poolConfig["ConnectRetryBackoff"] = m_settings->value("ConnectRetryBackoff", "1000").toString();
+    m_settings->endGroup();
+}
+
+//界面配置：登录页显示后是否在空闲时预热注册页与主内容页，以及预热前的延迟（毫秒）
+void configmanager::loadUi() {
+    m_settings->beginGroup("UI");
+    m_prewarmPages = m_settings->value("PrewarmPages", true).toBool();
+    m_prewarmDelay = m_settings->value("PrewarmDelay", 500).toInt();
+    m_settings->endGroup();
+}
+
 void configmanager::loadSubsysPath(){
     for(int i = 1; i < 5; i++){
         QString GroupName = QString("Subsystem%1").arg(i);
@@ -118,6 +159,18 @@ QMap<QString,QString> configmanager::getDbConfig() const{
     return m_dbConfig;
 }
 
+QMap<QString,QString> configmanager::getPoolConfig() const{
+    return m_poolConfig;
+}
+
+bool configmanager::getPrewarmPages() const{
+    return m_prewarmPages;
+}
+
+int configmanager::getPrewarmDelay() const{
+    return m_prewarmDelay;
+}
+
 QString configmanager::getSubsysPath(int index) const{
     return m_subsysPath.value(index, "");
 }
@@ -24,6 +24,9 @@ public:
     QString getLogPath() const;
     QString getDbType() const;
     QMap<QString,QString> getDbConfig() const;
+    QMap<QString,QString> getPoolConfig() const;
+    bool getPrewarmPages() const;
+    int getPrewarmDelay() const;
     QString getSubsysPath(int index) const;
     QString getSubsysPort(int index) const;
     QString getSubsysHost(int index) const;
@@ -37,6 +40,9 @@ private:
     QString m_logPath;
     QString m_dbType;
     QMap<QString,QString> m_dbConfig;
+    QMap<QString,QString> m_poolConfig;
+    bool m_prewarmPages;
+    int m_prewarmDelay;
     QMap<int, QString> m_subsysPath;
     QMap<int, QString> m_subsysPort;
     QMap<int, QString> m_subsysHost;
@@ -44,6 +50,8 @@ private:
     //加载，通过m_settings将配置文件内容读取到成员变量中
     void loadLogPath();
     bool loadDatabase();
+    void loadPool();
+    void loadUi();
     void loadSubsysPath();
 
 };
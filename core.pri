@@ -0,0 +1,33 @@
+# 认证、配置与数据库模块（主程序与基准测试等工具共用）
+
+SOURCES += \
+    $$PWD/auth/authmanager.cpp \
+    $$PWD/auth/functionregistry.cpp \
+    $$PWD/auth/permissionexporter.cpp \
+    $$PWD/auth/userimporter.cpp \
+    $$PWD/auth/userinfo.cpp \
+    $$PWD/auth/usersession.cpp \
+    $$PWD/config/configmanager.cpp \
+    $$PWD/database/connectionpool.cpp \
+    $$PWD/database/databasemanager.cpp \
+    $$PWD/database/functioncatalog.cpp \
+    $$PWD/database/indexcatalog.cpp \
+    $$PWD/database/schemamigrator.cpp \
+    $$PWD/database/sqldialect.cpp \
+    $$PWD/database/userbulkwriter.cpp
+
+HEADERS += \
+    $$PWD/auth/authmanager.h \
+    $$PWD/auth/functionregistry.h \
+    $$PWD/auth/permissionexporter.h \
+    $$PWD/auth/userimporter.h \
+    $$PWD/auth/userinfo.h \
+    $$PWD/auth/usersession.h \
+    $$PWD/config/configmanager.h \
+    $$PWD/database/connectionpool.h \
+    $$PWD/database/databasemanager.h \
+    $$PWD/database/functioncatalog.h \
+    $$PWD/database/indexcatalog.h \
+    $$PWD/database/schemamigrator.h \
+    $$PWD/database/sqldialect.h \
+    $$PWD/database/userbulkwriter.h
@@ -0,0 +1,535 @@
+#include "connectionpool.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStringList>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QAbstractEventDispatcher>
+#include <QDebug>
+#include <utility>
+
+namespace {
+// 连接名在进程内全局唯一（QSqlDatabase 的连接名是全局的，多个连接池不能重名）
+QAtomicInt nextConnectionSerial(0);
+}
+
+connectionpool::connectionpool()
+    : m_open(false)
+    , m_statementPrepares(0)
+    , m_statementReuses(0)
+    , m_active(0)
+    , m_pending(0)
+    , m_lastError("")
+    , m_lifetime(std::make_shared<bool>(true))
+{
+    m_clock.start();
+}
+
+connectionpool::~connectionpool()
+{
+    // 之后执行的排队关闭请求直接返回
+    m_lifetime.reset();
+    closeAll();
+}
+
+//初始化连接池
+bool connectionpool::init(const QString &driverName, const QMap<QString, QString> &dbConfig, const poolconfig &config)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_open) {
+            return true;
+        }
+        m_driverName = driverName;
+        m_dbConfig = dbConfig;
+        m_config = config;
+        if (m_config.maxSize < 1) {
+            m_config.maxSize = 1;
+        }
+        if (m_config.minSize < 0) {
+            m_config.minSize = 0;
+        }
+        if (m_config.minSize > m_config.maxSize) {
+            m_config.minSize = m_config.maxSize;
+        }
+        m_open = true;
+    }
+
+    // 在调用线程中预热最小连接数（至少建立一个连接，用于验证连接参数）
+    QStringList warm;
+    const int warmCount = qMax(1, m_config.minSize);
+    for (int i = 0; i < warmCount; ++i) {
+        QString name = acquire();
+        if (name.isEmpty()) {
+            break;
+        }
+        warm.append(name);
+    }
+    for (const QString &name : warm) {
+        release(name);
+    }
+
+    if (warm.isEmpty()) {
+        QString error = getLastError();
+        closeAll();
+        QMutexLocker locker(&m_mutex);
+        m_lastError = error;
+        return false;
+    }
+
+    qDebug() << "连接池初始化成功，最小连接数:" << m_config.minSize << "最大连接数:" << m_config.maxSize;
+    return true;
+}
+
+bool connectionpool::isOpen() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_open;
+}
+
+//借出一个属于当前线程的连接
+QString connectionpool::acquire()
+{
+    QThread *thread = QThread::currentThread();
+    QElapsedTimer waited;
+    waited.start();
+    bool stole = false;
+
+    for (;;) {
+        QString name;
+        bool create = false;
+        qint64 idleFor = 0;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_open) {
+                m_lastError = "连接池未初始化";
+                return QString();
+            }
+            watchThread(thread);
+            evictIdle(thread, m_clock.elapsed());
+
+            QList<idleconnection> &idle = m_idle[thread];
+            if (!idle.isEmpty()) {
+                // 后进先出：优先使用最近归还的连接
+                const idleconnection entry = idle.takeLast();
+                name = entry.name;
+                idleFor = m_clock.elapsed() - entry.idleSince;
+            } else if (m_owner.size() + m_pending < m_config.maxSize) {
+                name = QString("learn1_pool_%1").arg(nextConnectionSerial.fetchAndAddRelaxed(1) + 1);
+                create = true;
+                ++m_pending;
+            } else {
+                // 已达最大连接数：请其他线程关闭一个最久未用的空闲连接（每次借用最多一次），
+                // 连接真正关闭、名额空出后才会被唤醒
+                if (!stole) {
+                    stole = stealIdle(thread);
+                }
+                const qint64 remaining = m_config.borrowTimeoutMs - waited.elapsed();
+                if (remaining <= 0) {
+                    m_lastError = QString("获取数据库连接超时（已达到最大连接数 %1）").arg(m_config.maxSize);
+                    qDebug() << m_lastError;
+                    return QString();
+                }
+                m_released.wait(&m_mutex, static_cast<unsigned long>(remaining));
+                continue;
+            }
+            ++m_active;
+        }
+
+        if (create) {
+            // 建立连接可能较慢，不持有锁
+            QString error;
+            const bool opened = openConnection(name, &error);
+
+            QMutexLocker locker(&m_mutex);
+            --m_pending;
+            if (!opened) {
+                --m_active;
+                m_lastError = error;
+                qDebug() << m_lastError;
+                m_released.wakeAll();
+                return QString();
+            }
+            m_owner.insert(name, thread);
+            return name;
+        }
+
+        if (!m_config.validateOnBorrow || idleFor < m_config.validateIdleMs || validate(name)) {
+            return name;
+        }
+
+        // 校验失败：丢弃该连接并重新获取
+        qDebug() << "数据库连接校验失败，丢弃连接:" << name;
+        QMutexLocker locker(&m_mutex);
+        --m_active;
+        removeConnection(name);
+    }
+}
+
+//归还连接
+void connectionpool::release(const QString &connectionName)
+{
+    QMutexLocker locker(&m_mutex);
+    QThread *thread = m_owner.value(connectionName, nullptr);
+    if (!thread) {
+        return;
+    }
+    --m_active;
+
+    idleconnection entry;
+    entry.name = connectionName;
+    entry.idleSince = m_clock.elapsed();
+    m_idle[thread].append(entry);
+
+    evictIdle(thread, entry.idleSince);
+    m_released.wakeAll();
+}
+
+//关闭并移除所有连接
+void connectionpool::closeAll()
+{
+    QMutexLocker locker(&m_mutex);
+    for (const QMetaObject::Connection &watch : std::as_const(m_threadWatches)) {
+        QObject::disconnect(watch);
+    }
+    m_threadWatches.clear();
+
+    const QStringList names = m_owner.keys();
+    for (const QString &name : names) {
+        removeConnection(name);
+    }
+    m_idle.clear();
+    m_retired.clear();
+    m_active = 0;
+    m_open = false;
+    m_released.wakeAll();
+}
+
+//获取指定连接上已预编译的语句
+QSqlQuery &connectionpool::preparedQuery(const QString &connectionName, const QString &sql)
+{
+    QSqlQuery *query = nullptr;
+    {
+        QMutexLocker locker(&m_mutex);
+        QHash<QString, cachedstatement> &statements = m_statements[connectionName];
+        auto it = statements.find(sql);
+        if (it == statements.end()) {
+            cachedstatement created;
+            created.query = new QSqlQuery(QSqlDatabase::database(connectionName, false));
+            created.query->setForwardOnly(true);
+            it = statements.insert(sql, created);
+        } else if (it.value().prepared) {
+            ++m_statementReuses;
+            return *it.value().query;
+        }
+        ++m_statementPrepares;
+        query = it.value().query;
+    }
+
+    // prepare 只访问该连接，连接只在所属线程中使用，无需持锁
+    const bool prepared = query->prepare(sql);
+    if (!prepared) {
+        qDebug() << "预编译语句失败:" << query->lastError().text() << sql;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_statements[connectionName].find(sql);
+    if (it != m_statements[connectionName].end()) {
+        it.value().prepared = prepared;
+    }
+    return *query;
+}
+
+statementcachestats connectionpool::statementStats() const
+{
+    QMutexLocker locker(&m_mutex);
+    statementcachestats stats;
+    stats.prepares = m_statementPrepares;
+    stats.reuses = m_statementReuses;
+    for (auto it = m_statements.cbegin(); it != m_statements.cend(); ++it) {
+        stats.cached += it.value().size();
+    }
+    return stats;
+}
+
+int connectionpool::totalCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_owner.size();
+}
+
+int connectionpool::idleCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    int count = 0;
+    for (auto it = m_idle.cbegin(); it != m_idle.cend(); ++it) {
+        count += it.value().size();
+    }
+    return count;
+}
+
+int connectionpool::activeCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_active;
+}
+
+QString connectionpool::getLastError() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lastError;
+}
+
+//建立新连接（在调用线程中创建，归属该线程）
+bool connectionpool::openConnection(const QString &name, QString *error)
+{
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(m_driverName, name);
+        if (m_driverName == "QSQLITE") {
+            // SQLite 只需要数据库文件路径；file: 开头的按 URI 打开（如共享的内存数据库）
+            const QString databaseName = m_dbConfig.value("DatabaseName", "learn1.db");
+            db.setDatabaseName(databaseName);
+            QStringList options;
+            if (databaseName.startsWith("file:")) {
+                options << "QSQLITE_OPEN_URI";
+            }
+            if (m_config.sqlite.busyTimeoutMs > 0) {
+                options << QString("QSQLITE_BUSY_TIMEOUT=%1").arg(m_config.sqlite.busyTimeoutMs);
+            }
+            if (m_config.sqlite.sharedCache) {
+                options << "QSQLITE_ENABLE_SHARED_CACHE";
+            }
+            db.setConnectOptions(options.join(';'));
+        } else {
+            db.setHostName(m_dbConfig.value("Host", "localhost"));
+            db.setPort(m_dbConfig.value("Port", "5236").toInt());
+            db.setDatabaseName(m_dbConfig.value("DatabaseName", ""));
+            db.setUserName(m_dbConfig.value("UID", ""));
+            db.setPassword(m_dbConfig.value("Password", ""));
+            if (m_config.connectTimeoutSec > 0) {
+                // 主机不可达时不必等待驱动默认的超时
+                db.setConnectOptions(QString("SQL_ATTR_LOGIN_TIMEOUT=%1;SQL_ATTR_CONNECTION_TIMEOUT=%1").arg(m_config.connectTimeoutSec));
+            }
+        }
+
+        if (db.open()) {
+            if (m_driverName != "QSQLITE" || applySqliteProfile(db, error)) {
+                return true;
+            }
+            db.close();
+        } else {
+            *error = QString("数据库连接失败: %1").arg(db.lastError().text());
+        }
+    }
+    QSqlDatabase::removeDatabase(name);
+    return false;
+}
+
+//SQLite 的日志模式、同步级别、缓存等都是连接级设置，每个新连接都要执行一次
+bool connectionpool::applySqliteProfile(const QSqlDatabase &db, QString *error) const
+{
+    const sqliteprofile &profile = m_config.sqlite;
+    QStringList pragmas;
+    if (!profile.journalMode.isEmpty()) {
+        pragmas << QString("PRAGMA journal_mode = %1").arg(profile.journalMode);
+    }
+    if (!profile.synchronous.isEmpty()) {
+        pragmas << QString("PRAGMA synchronous = %1").arg(profile.synchronous);
+    }
+    pragmas << QString("PRAGMA mmap_size = %1").arg(profile.mmapSize)
+            << QString("PRAGMA cache_size = %1").arg(profile.cacheSize)
+            << QString("PRAGMA foreign_keys = %1").arg(profile.foreignKeys ? "ON" : "OFF");
+
+    QSqlQuery query(db);
+    for (const QString &pragma : pragmas) {
+        if (!query.exec(pragma)) {
+            *error = QString("设置 SQLite 参数失败（%1）: %2").arg(pragma, query.lastError().text());
+            return false;
+        }
+        query.finish();
+    }
+    return true;
+}
+
+//移除连接（调用方需持有 m_mutex）
+void connectionpool::removeConnection(const QString &name)
+{
+    // 先释放该连接上的预编译语句，再移除连接
+    const QHash<QString, cachedstatement> statements = m_statements.take(name);
+    for (const cachedstatement &statement : statements) {
+        delete statement.query;
+    }
+    m_owner.remove(name);
+    QSqlDatabase::removeDatabase(name);
+}
+
+//校验连接是否可用
+bool connectionpool::validate(const QString &name) const
+{
+    QSqlDatabase db = QSqlDatabase::database(name, false);
+    if (!db.isOpen()) {
+        return false;
+    }
+    QSqlQuery query(db);
+    const bool ok = query.exec(m_config.validationQuery);
+    query.finish();
+    return ok;
+}
+
+//回收指定线程中超时的空闲连接，保留最小连接数（调用方需持有 m_mutex）
+void connectionpool::evictIdle(QThread *thread, qint64 now)
+{
+    closeRetired(thread);
+
+    auto it = m_idle.find(thread);
+    if (it == m_idle.end() || m_config.idleTimeoutMs <= 0) {
+        return;
+    }
+
+    int owned = 0;
+    for (auto ownerIt = m_owner.cbegin(); ownerIt != m_owner.cend(); ++ownerIt) {
+        if (ownerIt.value() == thread) {
+            ++owned;
+        }
+    }
+
+    // 空闲列表按归还时间排序，最早归还的在前
+    QList<idleconnection> &idle = it.value();
+    while (!idle.isEmpty() && owned > m_config.minSize
+           && now - idle.first().idleSince > m_config.idleTimeoutMs) {
+        removeConnection(idle.takeFirst().name);
+        --owned;
+    }
+}
+
+//已达最大连接数时，请其他线程关闭其最久未用的空闲连接以腾出名额（调用方需持有 m_mutex）
+bool connectionpool::stealIdle(QThread *requester)
+{
+    QThread *victim = nullptr;
+    qint64 oldest = 0;
+    for (auto it = m_idle.cbegin(); it != m_idle.cend(); ++it) {
+        if (it.key() == requester || it.value().isEmpty()) {
+            continue;
+        }
+        if (!victim || it.value().first().idleSince < oldest) {
+            victim = it.key();
+            oldest = it.value().first().idleSince;
+        }
+    }
+    if (!victim) {
+        return false;
+    }
+    // 预编译语句与连接都属于 victim 线程，只能由该线程关闭；关闭前连接仍计入最大连接数
+    m_retired[victim].append(m_idle[victim].takeFirst().name);
+    requestCloseRetired(victim);
+    return true;
+}
+
+//关闭当前线程中已让出名额的连接
+void connectionpool::closeRetired(QThread *thread)
+{
+    auto it = m_retired.find(thread);
+    if (it == m_retired.end()) {
+        return;
+    }
+    const QStringList names = it.value();
+    m_retired.erase(it);
+    for (const QString &name : names) {
+        removeConnection(name);
+    }
+    m_released.wakeAll();
+}
+
+//请求 thread 关闭其待关闭的连接（调用方需持有 m_mutex）
+void connectionpool::requestCloseRetired(QThread *thread)
+{
+    // 事件分发器属于 thread，排队调用在该线程的事件循环中执行（界面线程会立即处理）
+    QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance(thread);
+    if (!dispatcher) {
+        return;
+    }
+    const std::weak_ptr<bool> lifetime = m_lifetime;
+    QMetaObject::invokeMethod(dispatcher, [this, thread, lifetime]() {
+        if (lifetime.expired()) {
+            return;
+        }
+        QMutexLocker locker(&m_mutex);
+        closeRetired(thread);
+    }, Qt::QueuedConnection);
+}
+
+//监听线程结束信号（调用方需持有 m_mutex）
+void connectionpool::watchThread(QThread *thread)
+{
+    if (m_threadWatches.contains(thread)) {
+        return;
+    }
+    // 直接连接：finished 信号在结束的线程中发出，清理也在该线程中执行
+    m_threadWatches.insert(thread, QObject::connect(thread, &QThread::finished, [this, thread]() {
+        releaseThread(thread);
+    }));
+}
+
+//线程结束时清理其全部连接
+void connectionpool::releaseThread(QThread *thread)
+{
+    QMutexLocker locker(&m_mutex);
+    QObject::disconnect(m_threadWatches.take(thread));
+
+    const QList<idleconnection> idle = m_idle.take(thread);
+    const QStringList retired = m_retired.take(thread);
+    const QStringList names = m_owner.keys(thread);
+    m_active -= names.size() - idle.size() - retired.size();
+    for (const QString &name : names) {
+        removeConnection(name);
+    }
+    m_released.wakeAll();
+}
+
+
+connectionguard::connectionguard(connectionpool *pool)
+    : m_pool(pool)
+{
+    if (m_pool) {
+        m_name = m_pool->acquire();
+    }
+}
+
+connectionguard::~connectionguard()
+{
+    if (m_pool && !m_name.isEmpty()) {
+        m_pool->release(m_name);
+    }
+}
+
+bool connectionguard::isValid() const
+{
+    return !m_name.isEmpty();
+}
+
+QSqlDatabase connectionguard::database() const
+{
+    if (m_name.isEmpty()) {
+        return QSqlDatabase();
+    }
+    return QSqlDatabase::database(m_name, false);
+}
+
+QString connectionguard::connectionName() const
+{
+    return m_name;
+}
+
+QSqlQuery &connectionguard::prepared(const QString &sql)
+{
+    if (!m_pool || m_name.isEmpty()) {
+        // 未借到连接：返回一个绑定在无效连接上的查询，执行时会失败并给出错误
+        if (!m_invalidQuery) {
+            m_invalidQuery.reset(new QSqlQuery(QSqlDatabase()));
+        }
+        return *m_invalidQuery;
+    }
+    return m_pool->preparedQuery(m_name, sql);
+}
@@ -0,0 +1,171 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QMap>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <memory>
+
+class QThread;
+
+//SQLite 连接参数（Type=SQLITE 时生效，每个连接建立后执行对应的 PRAGMA）
+struct sqliteprofile
+{
+    QString journalMode = "WAL";      // 日志模式：WAL 下读写互不阻塞
+    QString synchronous = "NORMAL";   // WAL 下 NORMAL 只在检查点时同步，掉电最多丢失最近的事务
+    qint64 mmapSize = 268435456;      // 内存映射读取的字节数，0 表示关闭
+    int cacheSize = -65536;           // 页缓存大小，负数表示 KiB（-65536 即 64 MiB）
+    int busyTimeoutMs = 5000;         // 数据库被锁定时的等待时间
+    bool sharedCache = false;         // 同一进程内的连接共享页缓存（表级锁，WAL 下通常更慢）
+    bool foreignKeys = true;          // 启用外键约束（使 ON DELETE CASCADE 生效）
+};
+
+//连接池参数（来自 config.ini 的 [Database] 段）
+struct poolconfig
+{
+    int minSize = 1;                 // 每个线程预热的最小连接数
+    int maxSize = 8;                 // 全局最大连接数
+    int idleTimeoutMs = 300000;      // 空闲连接超过该时长被回收
+    int borrowTimeoutMs = 5000;      // 借用连接时的最长等待时间
+    bool validateOnBorrow = true;    // 借出前是否执行校验语句
+    int validateIdleMs = 30000;      // 只校验空闲超过该时长的连接（刚归还的连接直接借出，不增加往返）
+    int connectTimeoutSec = 5;       // 建立连接（登录）超时，0 表示使用驱动默认值
+    QString validationQuery = "SELECT 1";
+    sqliteprofile sqlite;
+};
+
+//预编译语句缓存统计
+struct statementcachestats
+{
+    qint64 prepares = 0;   // 实际执行 prepare 的次数
+    qint64 reuses = 0;     // 复用已预编译语句（节省的 prepare）次数
+    int cached = 0;        // 当前缓存的语句数
+};
+
+//数据库连接池
+//QSqlDatabase 只能在创建它的线程中使用，因此连接按线程归属管理：
+//每个线程只会拿到自己创建的连接，最大连接数在所有线程间共享
+class connectionpool
+{
+public:
+    connectionpool();
+    ~connectionpool();
+
+    //初始化连接池（保存连接参数，并在调用线程中预热最小连接数）
+    bool init(const QString &driverName, const QMap<QString, QString> &dbConfig, const poolconfig &config);
+
+    //连接池是否已初始化
+    bool isOpen() const;
+
+    //借出一个属于当前线程的连接，失败返回空字符串
+    QString acquire();
+
+    //归还连接
+    void release(const QString &connectionName);
+
+    //关闭并移除所有连接
+    void closeAll();
+
+    //获取指定连接上已预编译的语句（按 SQL 文本缓存，复用时只需重新绑定参数）
+    //仅可在连接所属线程中使用；用完后调用 finish()。缓存面向代码中固定的 SQL 文本，不设上限
+    QSqlQuery &preparedQuery(const QString &connectionName, const QString &sql);
+
+    //统计信息
+    statementcachestats statementStats() const;
+    int totalCount() const;
+    int idleCount() const;
+    int activeCount() const;
+
+    //返回错误信息
+    QString getLastError() const;
+
+private:
+    struct idleconnection
+    {
+        QString name;
+        qint64 idleSince;
+    };
+
+    struct cachedstatement
+    {
+        QSqlQuery *query = nullptr;
+        bool prepared = false;
+    };
+
+    //在当前线程中建立新连接
+    bool openConnection(const QString &name, QString *error);
+    //对新建的 SQLite 连接执行 PRAGMA
+    bool applySqliteProfile(const QSqlDatabase &db, QString *error) const;
+    //移除连接（调用方需持有 m_mutex）
+    void removeConnection(const QString &name);
+    //校验连接是否可用
+    bool validate(const QString &name) const;
+    //回收指定线程中超时的空闲连接（调用方需持有 m_mutex）
+    void evictIdle(QThread *thread, qint64 now);
+    //把其他线程最久未用的空闲连接标记为待关闭，并请求所属线程关闭它（调用方需持有 m_mutex）
+    //连接只在所属线程中关闭，关闭前仍计入最大连接数，见 closeRetired
+    bool stealIdle(QThread *requester);
+    //关闭当前线程中被标记为待关闭的连接并唤醒等待者（调用方需持有 m_mutex，且必须在 thread 中调用）
+    void closeRetired(QThread *thread);
+    //通过 thread 的事件循环排队调用 closeRetired；没有事件循环的线程在下次借用/归还或线程结束时关闭
+    void requestCloseRetired(QThread *thread);
+    //线程结束时在该线程中清理其全部连接
+    void watchThread(QThread *thread);
+    void releaseThread(QThread *thread);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_released;
+
+    QString m_driverName;
+    QMap<QString, QString> m_dbConfig;
+    poolconfig m_config;
+    bool m_open;
+
+    QHash<QThread*, QList<idleconnection>> m_idle;   // 每个线程的空闲连接
+    QHash<QString, QThread*> m_owner;                // 所有连接及其所属线程
+    QHash<QThread*, QMetaObject::Connection> m_threadWatches;
+    QHash<QThread*, QStringList> m_retired;          // 等待所属线程关闭的连接（关闭前仍在 m_owner 中，计入最大连接数）
+    QHash<QString, QHash<QString, cachedstatement>> m_statements;  // 连接名 -> SQL -> 预编译语句
+    qint64 m_statementPrepares;
+    qint64 m_statementReuses;
+    QElapsedTimer m_clock;
+    int m_active;                                    // 已借出的连接数
+    int m_pending;                                   // 正在建立的连接数
+    QString m_lastError;
+    std::shared_ptr<bool> m_lifetime;                // 排队的关闭请求据此判断连接池是否已销毁
+};
+
+//RAII 连接守卫：构造时借出连接，析构时自动归还
+class connectionguard
+{
+public:
+    explicit connectionguard(connectionpool *pool);
+    ~connectionguard();
+
+    //是否成功借到连接
+    bool isValid() const;
+
+    //获取借到的数据库连接
+    QSqlDatabase database() const;
+
+    QString connectionName() const;
+
+    //获取该连接上缓存的预编译语句（未借到连接时返回一个无效查询，执行会失败）
+    QSqlQuery &prepared(const QString &sql);
+
+private:
+    Q_DISABLE_COPY(connectionguard)
+
+    connectionpool *m_pool;
+    QString m_name;
+    std::unique_ptr<QSqlQuery> m_invalidQuery;
+};
+
+#endif // CONNECTIONPOOL_H
@@ -1,21 +1,26 @@
 #include "databasemanager.h"
+#include "schemamigrator.h"
 #include "../config/configmanager.h"
-#include <QCryptographicHash>
+#include <QVariant>
+#include <QThread>
+#include <QElapsedTimer>
 
 databasemanager::databasemanager(configmanager *config)
     :m_configManager(config),
-    m_lastError("")
+    m_lastError(""),
+    m_abortOpen(false),
+    m_catalogLoaded(false)
 {
     
 }
 
 databasemanager::~databasemanager() {
-    if(m_db.isOpen()) {
-        m_db.close();
-    }
+    const statementcachestats stats = m_pool.statementStats();
+    qDebug() << "预编译语句缓存统计 prepare:" << stats.prepares << "复用（节省的prepare）:" << stats.reuses << "缓存语句:" << stats.cached;
+    m_pool.closeAll();
 }
 
-//建立数据库连接
+//建立数据库连接（初始化连接池）
 bool databasemanager::connectDatabase(){
     // 步骤1：检查配置管理器
     if (!m_configManager) {
@@ -31,7 +36,7 @@ bool databasemanager::connectDatabase(){
     }
 
     // 步骤2：检查是否已经连接
-    if (m_db.isOpen()) {
+    if (m_pool.isOpen()) {
         qDebug() << "数据库已连接";
         return true;
     }
@@ -39,8 +44,9 @@ bool databasemanager::connectDatabase(){
     // 步骤3：从配置管理器读取数据库配置
     QString dbType = m_configManager->getDbType();
     QMap<QString, QString> dbConfig = m_configManager->getDbConfig();
+    QMap<QString, QString> poolSettings = m_configManager->getPoolConfig();
 
-    //步骤4：根据数据库类型创建连接
+    //步骤4：根据数据库类型选择驱动
     QString driverName;
     if(dbType.toUpper() == "SQLITE" || dbType.toUpper() == "QSQLITE"){
         driverName = "QSQLITE";
@@ -52,41 +58,117 @@ bool databasemanager::connectDatabase(){
         return false;
     }
 
-    // 步骤5：创建数据库连接
-    m_db = QSqlDatabase::addDatabase(driverName);
-
-    // 步骤6：设置连接参数
+    // 步骤5：读取连接池参数
+    poolconfig config;
+    config.minSize = poolSettings.value("PoolMinSize", "1").toInt();
+    config.maxSize = poolSettings.value("PoolMaxSize", "8").toInt();
+    config.idleTimeoutMs = poolSettings.value("PoolIdleTimeout", "300").toInt() * 1000;
+    config.borrowTimeoutMs = poolSettings.value("PoolBorrowTimeout", "5000").toInt();
+    config.validateOnBorrow = QVariant(poolSettings.value("PoolValidateOnBorrow", "true")).toBool();
+    config.validateIdleMs = poolSettings.value("PoolValidateIdle", "30").toInt() * 1000;
+    config.connectTimeoutSec = poolSettings.value("ConnectTimeout", "5").toInt();
     if (driverName == "QSQLITE") {
-        // SQLite 只需要数据库文件路径
-        QString dbName = dbConfig.value("DatabaseName", "learn1.db");
-        m_db.setDatabaseName(dbName);
-    } else {
-        // 其他数据库需要更多参数
-        m_db.setHostName(dbConfig.value("Host", "localhost"));
-        m_db.setPort(dbConfig.value("Port", "5236").toInt());
-        m_db.setDatabaseName(dbConfig.value("DatabaseName", ""));
-        m_db.setUserName(dbConfig.value("UID", ""));
-        m_db.setPassword(dbConfig.value("Password", ""));
+        config.sqlite = loadSqliteProfile(dbConfig);
     }
 
-    // 步骤7：打开连接
-    if (!m_db.open()) {
-        m_lastError = QString("数据库连接失败: %1").arg(m_db.lastError().text());
+    // 步骤6：初始化连接池（在当前线程建立首个连接以验证参数）
+    if (!m_pool.init(driverName, dbConfig, config)) {
+        m_lastError = m_pool.getLastError();
         qDebug() << m_lastError;
         return false;
     }
 
-
-    // 步骤8：连接成功
+    // 步骤7：连接成功
     qDebug() << "数据库连接成功";
     return true;
 }
 
+//读取 SQLite 连接参数；日志模式与同步级别会拼入 PRAGMA，只接受 SQLite 定义的取值
+sqliteprofile databasemanager::loadSqliteProfile(const QMap<QString, QString> &dbConfig)
+{
+    static const QStringList journalModes = {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+    static const QStringList synchronousModes = {"OFF", "NORMAL", "FULL", "EXTRA"};
+
+    sqliteprofile profile;
+    const QString journalMode = dbConfig.value("JournalMode", profile.journalMode).trimmed().toUpper();
+    if (journalModes.contains(journalMode)) {
+        profile.journalMode = journalMode;
+    } else {
+        qDebug() << "无效的 JournalMode:" << journalMode << "，使用" << profile.journalMode;
+    }
+    const QString synchronous = dbConfig.value("Synchronous", profile.synchronous).trimmed().toUpper();
+    if (synchronousModes.contains(synchronous)) {
+        profile.synchronous = synchronous;
+    } else {
+        qDebug() << "无效的 Synchronous:" << synchronous << "，使用" << profile.synchronous;
+    }
+    profile.mmapSize = qMax<qint64>(0, dbConfig.value("MmapSize", QString::number(profile.mmapSize)).toLongLong());
+    profile.cacheSize = dbConfig.value("CacheSize", QString::number(profile.cacheSize)).toInt();
+    profile.busyTimeoutMs = qMax(0, dbConfig.value("BusyTimeout", QString::number(profile.busyTimeoutMs)).toInt());
+    profile.sharedCache = QVariant(dbConfig.value("SharedCache", "false")).toBool();
+    profile.foreignKeys = QVariant(dbConfig.value("ForeignKeys", "true")).toBool();
+    return profile;
+}
+
 
 
+//连接数据库并迁移结构，连接失败时重试
+startupresult databasemanager::openBackend()
+{
+    startupresult result;
+    m_abortOpen = false;
+
+    int retries = 3;
+    int backoffMs = 1000;
+    if (m_configManager) {
+        const QMap<QString, QString> poolSettings = m_configManager->getPoolConfig();
+        retries = qMax(0, poolSettings.value("ConnectRetries", "3").toInt());
+        backoffMs = qMax(0, poolSettings.value("ConnectRetryBackoff", "1000").toInt());
+    }
+
+    for (;;) {
+        ++result.attempts;
+        if (connectDatabase()) {
+            result.connected = true;
+            break;
+        }
+        // 配置错误（而非数据库不可达）时重试没有意义
+        if (!m_configManager || !m_configManager->isInitialized() || result.attempts > retries) {
+            result.error = m_lastError;
+            return result;
+        }
+
+        // 指数退避，最长 30 秒；分段等待以便及时响应中止
+        const qint64 delay = qMin<qint64>(30000, static_cast<qint64>(backoffMs) << qMin(result.attempts - 1, 15));
+        qDebug() << "数据库连接失败，" << delay << "毫秒后重试（第" << result.attempts << "次）";
+        QElapsedTimer waited;
+        waited.start();
+        while (waited.elapsed() < delay) {
+            if (m_abortOpen) {
+                result.error = m_lastError;
+                return result;
+            }
+            QThread::msleep(50);
+        }
+    }
+
+    if (!migrateSchema()) {
+        result.error = m_lastError;
+        return result;
+    }
+    result.ready = true;
+    return result;
+}
+
+//中止后台连接的重试等待
+void databasemanager::abortOpenBackend()
+{
+    m_abortOpen = true;
+}
+
 //判断数据库是否连接
 bool databasemanager::isConnected() const{
-    return m_db.isOpen();
+    return m_pool.isOpen();
 }
 
 
@@ -98,8 +180,8 @@ QString databasemanager::getLastError() const{
 
 //断开连接
 bool databasemanager::disconnected(){
-    if (m_db.isOpen()) {
-        m_db.close();
+    if (m_pool.isOpen()) {
+        m_pool.closeAll();
         qDebug() << "数据库连接已断开";
         return true;
     } else {
@@ -109,193 +191,68 @@ bool databasemanager::disconnected(){
     }
 }
 
-//初始化用户表
-bool databasemanager::initUserTable()
+//按 SchemaVersion 记录执行缺少的数据库结构迁移（已是最新版本时只执行一次查询）
+bool databasemanager::migrateSchema()
 {
-    if (!m_db.isOpen()) {
+    connectionguard conn(&m_pool);
+    if (!conn.isValid()) {
         m_lastError = "数据库未连接";
         qDebug() << m_lastError;
         return false;
     }
-    
-    // 创建用户表（包含role_type字段）
-    QString createTableSQL = 
-        "CREATE TABLE IF NOT EXISTS NowUsers ("
-        "userid INT PRIMARY KEY IDENTITY, "
-        "username VARCHAR(100) UNIQUE NOT NULL, "
-        "password VARCHAR(255) NOT NULL, "
-        "email VARCHAR(255), "
-        "name VARCHAR(100), "
-        "role_type INT DEFAULT 2"
-        ")";
-    
-    QSqlQuery query(m_db);
-    if (!query.exec(createTableSQL)) {
-        QString errorText = query.lastError().text();
-        // 如果表已存在，视为成功
-        if (errorText.contains("已存在") || errorText.contains("already exists")) {
-            qDebug() << "用户表已存在，跳过创建";
-        } else {
-            m_lastError = QString("创建用户表失败: %1").arg(errorText);
-            qDebug() << m_lastError;
-            return false;
-        }
-    } else {
-        qDebug() << "用户表创建成功";
-    }
-    query.finish();
-    
-    // 初始化超级管理员 adminjmh
-    // 先检查是否存在
-    QSqlQuery checkAdminQuery(m_db);
-    checkAdminQuery.prepare("SELECT COUNT(*) FROM NowUsers WHERE username = ?");
-    checkAdminQuery.addBindValue("adminjmh");
-    bool adminExists = false;
-    if (checkAdminQuery.exec() && checkAdminQuery.next()) {
-        int count = checkAdminQuery.value(0).toInt();
-        adminExists = (count > 0);
-    }
-    checkAdminQuery.finish();
-    
-    if (!adminExists) {
-        // 创建超级管理员，密码为adminjmh123（MD5加密）
-        QSqlQuery insertAdminQuery(m_db);
-        QString password = "adminjmh123";
-        QByteArray hash = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Md5);
-        QString passwordHash = hash.toHex();
-        
-        insertAdminQuery.prepare("INSERT INTO NowUsers (username, password, email, name, role_type) VALUES (?, ?, ?, ?, ?)");
-        insertAdminQuery.addBindValue("adminjmh");
-        insertAdminQuery.addBindValue(passwordHash);
-        insertAdminQuery.addBindValue("");
-        insertAdminQuery.addBindValue("超级管理员");
-        insertAdminQuery.addBindValue(1);  // role_type = 1 (admin)
-        
-        if (insertAdminQuery.exec()) {
-            qDebug() << "超级管理员adminjmh创建成功";
-            // 提交事务
-            if (!m_db.commit()) {
-                qDebug() << "提交事务失败:" << m_db.lastError().text();
-            }
-        } else {
-            qDebug() << "创建超级管理员失败:" << insertAdminQuery.lastError().text();
-        }
-        insertAdminQuery.finish();
-    } else {
-        qDebug() << "超级管理员adminjmh已存在";
-    }
-    
-    qDebug() << "用户表初始化成功";
-    return true;
-}
 
-//初始化用户权限表
-bool databasemanager::initUserPermissionsTable()
-{
-    if (!m_db.isOpen()) {
-        m_lastError = "数据库未连接";
-        qDebug() << m_lastError;
+    schemamigrator migrator(conn.database());
+    if (!migrator.migrate()) {
+        m_lastError = migrator.getLastError();
         return false;
     }
-    
-    // 创建用户权限表
-    QString createTableSQL = 
-        "CREATE TABLE IF NOT EXISTS NowUsersPermissions ("
-        "permissionid INT PRIMARY KEY IDENTITY, "
-        "userid INT NOT NULL, "
-        "function_id INT NOT NULL, "
-        "enabled INT DEFAULT 0, "
-        "FOREIGN KEY (userid) REFERENCES NowUsers(userid) ON DELETE CASCADE, "
-        "UNIQUE(userid, function_id)"
-        ")";
-    
-    QSqlQuery query(m_db);
-    if (!query.exec(createTableSQL)) {
-        QString errorText = query.lastError().text();
-        // 如果表已存在，视为成功
-        if (errorText.contains("已存在") || errorText.contains("already exists")) {
-            qDebug() << "用户权限表已存在，跳过创建";
-        } else {
-            m_lastError = QString("创建用户权限表失败: %1").arg(errorText);
-            qDebug() << m_lastError;
-            return false;
-        }
-    } else {
-        qDebug() << "用户权限表创建成功";
-    }
-    query.finish();
-    
-    // 为超级管理员adminjmh初始化所有权限（5个功能全部启用）
-    QSqlQuery adminQuery(m_db);
-    adminQuery.prepare("SELECT userid FROM NowUsers WHERE username = ?");
-    adminQuery.addBindValue("adminjmh");
-    int adminUserId = -1;
-    if (adminQuery.exec() && adminQuery.next()) {
-        adminUserId = adminQuery.value(0).toInt();
-    }
-    adminQuery.finish();
-    
-    if (adminUserId > 0) {
-        // 为adminjmh添加5个功能的权限（全部启用）
-        for (int funcId = 1; funcId <= 5; ++funcId) {
-            QSqlQuery permQuery(m_db);
-            permQuery.prepare("INSERT INTO NowUsersPermissions (userid, function_id, enabled) VALUES (?, ?, ?)");
-            permQuery.addBindValue(adminUserId);
-            permQuery.addBindValue(funcId);
-            permQuery.addBindValue(1);  // 启用
-            
-            if (!permQuery.exec()) {
-                QString errorText = permQuery.lastError().text();
-                // 如果已存在，忽略错误
-                if (errorText.contains("唯一") || errorText.contains("UNIQUE") || 
-                    errorText.contains("重复") || errorText.contains("duplicate")) {
-                    // 权限已存在，跳过
-                } else {
-                    qDebug() << "为adminjmh添加功能" << funcId << "权限失败:" << errorText;
-
-                }
-            }
-            permQuery.finish();
-        }
-        
-        // 提交事务
-        if (!m_db.commit()) {
-            qDebug() << "提交权限初始化事务失败:" << m_db.lastError().text();
-        } else {
-            qDebug() << "超级管理员权限初始化成功";
-        }
-    } else {
-        qDebug() << "未找到adminjmh用户，跳过权限初始化";
-    }
-    
-    qDebug() << "用户权限表初始化成功";
+    loadFunctionCatalog(conn.database());
     return true;
 }
 
-//获取数据库连接
-QSqlDatabase databasemanager::getDatabase() const
+//初始化用户表（由结构迁移完成，保留接口兼容旧调用）
+bool databasemanager::initUserTable()
 {
-    return m_db;
+    return migrateSchema();
 }
 
+//初始化用户权限表（由结构迁移完成，保留接口兼容旧调用）
+bool databasemanager::initUserPermissionsTable()
+{
+    return migrateSchema();
+}
 
+//获取连接池
+connectionpool *databasemanager::getConnectionPool()
+{
+    return &m_pool;
+}
 
+//获取 SQL 方言
+const sqldialect *databasemanager::getDialect() const
+{
+    return sqldialect::forDbType(m_configManager ? m_configManager->getDbType() : QString());
+}
 
+//获取功能目录
+functioncatalog databasemanager::getFunctionCatalog()
+{
+    QMutexLocker locker(&m_catalogMutex);
+    if (!m_catalogLoaded && m_pool.isOpen()) {
+        connectionguard conn(&m_pool);
+        if (conn.isValid()) {
+            m_functionCatalog.load(conn.database());
+            m_catalogLoaded = true;
+        }
+    }
+    return m_functionCatalog;
+}
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+//结构迁移后读取功能目录（读取失败时不再重试，使用内置功能）
+void databasemanager::loadFunctionCatalog(const QSqlDatabase &db)
+{
+    QMutexLocker locker(&m_catalogMutex);
+    m_functionCatalog.load(db);
+    m_catalogLoaded = true;
+    qDebug() << "功能目录已加载，功能数:" << m_functionCatalog.count();
+}
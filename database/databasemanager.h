@@ -5,9 +5,23 @@
 #include <QSqlError>
 #include <QDebug>
 #include <QString>
+#include <QMutex>
+#include <atomic>
+#include "connectionpool.h"
+#include "sqldialect.h"
+#include "functioncatalog.h"
 
 class configmanager;
 
+//后台启动（连接 + 结构迁移）的结果
+struct startupresult
+{
+    bool connected = false;   // 是否已连接数据库
+    bool ready = false;       // 连接成功且结构迁移完成
+    int attempts = 0;         // 连接尝试次数
+    QString error;
+};
+
 class databasemanager
 {
 public:
@@ -17,6 +31,13 @@ public:
     //建立数据库连接
     bool connectDatabase();
 
+    //连接数据库（失败时按配置重试，间隔指数退避），成功后执行结构迁移
+    //耗时操作，供启动时在后台线程调用
+    startupresult openBackend();
+
+    //中止 openBackend 的重试等待（线程安全）
+    void abortOpenBackend();
+
     //检查数据库是否已连接
     bool isConnected() const;
 
@@ -26,19 +47,40 @@ public:
     //断开连接
     bool disconnected();
 
-    //初始化用户表
+    //执行数据库结构迁移（建表、索引、初始化超级管理员），只执行缺少的步骤
+    bool migrateSchema();
+
+    //初始化用户表（等同于 migrateSchema）
     bool initUserTable();
     
-    //初始化用户权限表
+    //初始化用户权限表（等同于 migrateSchema）
     bool initUserPermissionsTable();
     
-    //获取数据库连接（供其他模块使用）
-    QSqlDatabase getDatabase() const;
+    //获取连接池（供其他模块通过 connectionguard 借用连接）
+    connectionpool *getConnectionPool();
+
+    //按配置的数据库类型（getDbType）选择的 SQL 方言
+    const sqldialect *getDialect() const;
+
+    //功能目录（结构迁移完成后读取一次并缓存，之后不再查询；线程安全）
+    //尚未读取时借用一个连接读取，因此不要在已借有连接的代码中调用
+    functioncatalog getFunctionCatalog();
 
 private:
-    QSqlDatabase m_db;
+    //读取并缓存功能目录（失败时使用内置功能）
+    void loadFunctionCatalog(const QSqlDatabase &db);
+
+    //从 [Database] 段读取 SQLite 连接参数（PRAGMA）
+    static sqliteprofile loadSqliteProfile(const QMap<QString, QString> &dbConfig);
+
+    connectionpool m_pool;
     configmanager *m_configManager;
     QString m_lastError;
+    std::atomic<bool> m_abortOpen;
+
+    QMutex m_catalogMutex;
+    functioncatalog m_functionCatalog;
+    bool m_catalogLoaded;
 };
 
 #endif // DATABASEMANAGER_H
@@ -0,0 +1,107 @@
+#include "functioncatalog.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QSet>
+#include <QDebug>
+
+functioncatalog::functioncatalog()
+    : m_allMask(0)
+    , m_lastError("")
+{
+    QList<functioninfo> builtin;
+    for (int i = 0; i < functionregistry::COUNT; ++i) {
+        functioninfo function;
+        function.id = functionregistry::FUNCTIONS[i].id;
+        function.label = QString::fromUtf8(functionregistry::FUNCTIONS[i].label);
+        function.order = i;
+        builtin.append(function);
+    }
+    setFunctions(builtin);
+}
+
+//读取功能目录（几十行，只在启动时执行一次）
+bool functioncatalog::load(const QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT id, label, subsystem, sort_order FROM Functions ORDER BY subsystem, sort_order, id")) {
+        m_lastError = QString("读取功能目录失败: %1").arg(query.lastError().text());
+        qDebug() << m_lastError;
+        return false;
+    }
+
+    QList<functioninfo> functions;
+    QSet<int> seen;
+    while (query.next()) {
+        functioninfo function;
+        function.id = query.value(0).toInt();
+        function.label = query.value(1).toString();
+        function.subsystem = query.value(2).toInt();
+        function.order = query.value(3).toInt();
+        // 编号必须能放进 perm_mask
+        if (!functionregistry::isValidId(function.id) || seen.contains(function.id)) {
+            qDebug() << "忽略无效的功能编号:" << function.id << function.label;
+            continue;
+        }
+        seen.insert(function.id);
+        functions.append(function);
+    }
+    query.finish();
+
+    if (functions.isEmpty()) {
+        m_lastError = "功能目录为空";
+        qDebug() << m_lastError;
+        return false;
+    }
+    setFunctions(functions);
+    m_lastError.clear();
+    return true;
+}
+
+const QList<functioninfo> &functioncatalog::functions() const
+{
+    return m_functions;
+}
+
+int functioncatalog::count() const
+{
+    return m_functions.size();
+}
+
+bool functioncatalog::contains(int functionId) const
+{
+    return m_positions.contains(functionId);
+}
+
+int functioncatalog::indexOf(int functionId) const
+{
+    return m_positions.value(functionId, -1);
+}
+
+QString functioncatalog::label(int functionId) const
+{
+    const int position = indexOf(functionId);
+    return position >= 0 ? m_functions.at(position).label : QString();
+}
+
+permmask functioncatalog::allMask() const
+{
+    return m_allMask;
+}
+
+QString functioncatalog::getLastError() const
+{
+    return m_lastError;
+}
+
+void functioncatalog::setFunctions(const QList<functioninfo> &functions)
+{
+    m_functions = functions;
+    m_positions.clear();
+    m_allMask = 0;
+    for (int i = 0; i < m_functions.size(); ++i) {
+        m_positions.insert(m_functions.at(i).id, i);
+        m_allMask |= functionregistry::bit(m_functions.at(i).id);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef FUNCTIONCATALOG_H
+#define FUNCTIONCATALOG_H
+#include <QSqlDatabase>
+#include <QString>
+#include <QList>
+#include <QHash>
+#include "../auth/functionregistry.h"
+
+//功能目录中的一项（Functions 表的一行）
+struct functioninfo
+{
+    int id = 0;          // function_id，决定在 perm_mask 中的位（1..63）
+    QString label;       // 主页面按钮与权限矩阵列的显示名称
+    int subsystem = 0;   // 所属子系统，主页面按子系统分组排列
+    int order = 0;       // 子系统内的顺序
+};
+
+//功能目录：启动时从 Functions 表读取一次，之后只读
+//按值传递的开销只是引用计数（QList/QHash 隐式共享），可在线程间复制
+//未加载或读取失败时为 functionregistry 中的内置功能
+class functioncatalog
+{
+public:
+    functioncatalog();
+
+    //从 Functions 表读取，成功后替换当前内容；失败时保留原内容
+    bool load(const QSqlDatabase &db);
+
+    //全部功能，按 subsystem、order、id 排序
+    const QList<functioninfo> &functions() const;
+    int count() const;
+
+    bool contains(int functionId) const;
+
+    //功能在 functions() 中的位置，不存在时返回 -1
+    int indexOf(int functionId) const;
+
+    //显示名称，不存在时返回空字符串
+    QString label(int functionId) const;
+
+    //目录中全部功能的掩码（管理员）
+    permmask allMask() const;
+
+    QString getLastError() const;
+
+private:
+    void setFunctions(const QList<functioninfo> &functions);
+
+    QList<functioninfo> m_functions;
+    QHash<int, int> m_positions;   // function_id -> 在 m_functions 中的位置
+    permmask m_allMask;
+    QString m_lastError;
+};
+
+#endif // FUNCTIONCATALOG_H
@@ -0,0 +1,62 @@
+#include "indexcatalog.h"
+#include "sqldialect.h"
+#include "../auth/functionregistry.h"
+
+QList<indexdef> indexcatalog::allIndexes()
+{
+    return QList<indexdef>()
+        // 按用户读取已启用功能（重新计算 perm_mask、权限矩阵）；function_id 在索引中，无需回表
+        << indexdef{"idx_perm_user_enabled", "NowUsersPermissions",
+                    QStringList() << "userid" << "enabled" << "function_id",
+                    "按 userid 读取已启用功能", 5, 0}
+        // 登录与用户名检查只需要这几列，按用户名查找时不必回表
+        // （SQLite 不支持 INCLUDE，DM 的普通索引同样用复合列覆盖）
+        << indexdef{"idx_users_login", "NowUsers",
+                    QStringList() << "username" << "userid" << "password" << "role_type",
+                    "登录、用户名是否存在", 7, 9}
+        // 登录与权限查询改为读取 perm_mask 后替换 idx_users_login
+        << indexdef{"idx_users_auth", "NowUsers",
+                    QStringList() << "username" << "userid" << "password" << "role_type" << "perm_mask",
+                    "登录、用户名是否存在、权限位掩码查询", 9, 0};
+}
+
+QList<indexdef> indexcatalog::indexes()
+{
+    QList<indexdef> active;
+    const QList<indexdef> all = allIndexes();
+    for (const indexdef &index : all) {
+        if (index.retiredVersion == 0) {
+            active.append(index);
+        }
+    }
+    return active;
+}
+
+QList<hotquery> indexcatalog::hotQueries(const sqldialect *dialect)
+{
+    return QList<hotquery>()
+        << hotquery{"login",
+                    "SELECT userid, password, role_type, perm_mask FROM NowUsers WHERE username = ?",
+                    QVariantList() << "adminjmh"}
+        << hotquery{"userExists",
+                    "SELECT COUNT(*) FROM NowUsers WHERE username = ?",
+                    QVariantList() << "adminjmh"}
+        << hotquery{"permissionMask",
+                    "SELECT role_type, perm_mask FROM NowUsers WHERE username = ?",
+                    QVariantList() << "adminjmh"}
+        // 保存权限后按权限表重新计算 perm_mask
+        << hotquery{"recomputePermissionMask",
+                    "SELECT " + functionregistry::maskSubquery("u.userid") + " FROM NowUsers u WHERE u.userid = ?",
+                    QVariantList() << 1}
+        // 保存权限时 upsert 按 (userid, function_id) 匹配已有行
+        << hotquery{"savePermissionMatch",
+                    "SELECT enabled FROM NowUsersPermissions WHERE userid = ? AND function_id = ?",
+                    QVariantList() << 1 << 1}
+        << hotquery{"updatePermissionMask",
+                    "UPDATE NowUsers SET perm_mask = "
+                    + functionregistry::maskSubquery("NowUsers.userid") + " WHERE userid = ?",
+                    QVariantList() << 1}
+        << hotquery{"usersPage",
+                    dialect->limit("SELECT username, email, name FROM NowUsers WHERE username > ? ORDER BY username", 501),
+                    QVariantList() << QString()};
+}
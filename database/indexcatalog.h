@@ -0,0 +1,45 @@
+#ifndef INDEXCATALOG_H
+#define INDEXCATALOG_H
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QList>
+
+class sqldialect;
+
+//一个受管理的索引
+struct indexdef
+{
+    QString name;
+    QString table;
+    QStringList columns;
+    QString purpose;         // 服务的查询
+    int version = 0;         // 创建该索引的结构版本
+    int retiredVersion = 0;  // 删除该索引的结构版本，0 表示仍在使用
+};
+
+//一条热点查询（与 AuthManager 中实际执行的语句保持一致，供 EXPLAIN 自检使用），计划中不应出现全表扫描
+struct hotquery
+{
+    QString name;
+    QString sql;
+    QVariantList bindValues;    // EXPLAIN 时绑定的示例参数
+};
+
+//认证热点路径的索引集合与对应查询
+//索引由结构迁移按版本创建与删除：新增或替换索引时在 allIndexes() 中追加（填写 version / retiredVersion），
+//并增加一个调用 schemamigrator::applyIndexChanges 的迁移步骤；已发布的条目不再修改
+class indexcatalog
+{
+public:
+    //全部受管理的索引（含已废弃的，不含主键与 UNIQUE 约束自带的索引）
+    static QList<indexdef> allIndexes();
+
+    //当前使用中的索引
+    static QList<indexdef> indexes();
+
+    //需要走索引的热点查询（行数限制等按方言生成）
+    static QList<hotquery> hotQueries(const sqldialect *dialect);
+};
+
+#endif // INDEXCATALOG_H
@@ -0,0 +1,339 @@
+#include "schemamigrator.h"
+#include "sqldialect.h"
+#include "indexcatalog.h"
+#include "../auth/functionregistry.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QVariantList>
+#include <QDebug>
+
+schemamigrator::schemamigrator(const QSqlDatabase &db)
+    : m_db(db)
+    , m_dialect(sqldialect::forDriver(db.driverName()))
+    , m_lastError("")
+{
+}
+
+//迁移步骤表：新增结构变更时在末尾追加一步，版本号递增
+QList<schemamigrator::migrationstep> schemamigrator::steps()
+{
+    return QList<migrationstep>()
+        << migrationstep{1, "创建结构版本表", &schemamigrator::createVersionTable}
+        << migrationstep{2, "创建用户表", &schemamigrator::createUserTable}
+        << migrationstep{3, "用户表增加 perm_version 列", &schemamigrator::addPermVersionColumn}
+        << migrationstep{4, "创建用户权限表", &schemamigrator::createPermissionsTable}
+        << migrationstep{5, "创建用户权限索引", &schemamigrator::createPermissionIndexes}
+        << migrationstep{6, "初始化超级管理员及其权限", &schemamigrator::seedAdmin}
+        << migrationstep{7, "创建认证热点查询的覆盖索引", &schemamigrator::createHotPathIndexes}
+        << migrationstep{8, "用户表增加 perm_mask 列", &schemamigrator::addPermMaskColumn}
+        << migrationstep{9, "登录覆盖索引改为包含 perm_mask", &schemamigrator::replaceLoginIndex}
+        << migrationstep{10, "创建功能目录表", &schemamigrator::createFunctionsTable}
+        << migrationstep{11, "删除用户表的 perm_version 列", &schemamigrator::dropPermVersionColumn};
+}
+
+int schemamigrator::latestVersion()
+{
+    return steps().last().version;
+}
+
+//当前数据库结构版本
+int schemamigrator::currentVersion()
+{
+    QSqlQuery query(m_db);
+    int version = 0;
+    // 表不存在时查询失败，视为版本 0
+    if (query.exec("SELECT MAX(version) FROM SchemaVersion") && query.next()) {
+        version = query.value(0).toInt();
+    }
+    query.finish();
+    return version;
+}
+
+//执行缺少的迁移步骤
+bool schemamigrator::migrate()
+{
+    if (!m_db.isOpen()) {
+        m_lastError = "数据库未连接";
+        return false;
+    }
+
+    const int current = currentVersion();
+    if (current >= latestVersion()) {
+        qDebug() << "数据库结构已是最新版本:" << current;
+        return true;
+    }
+
+    qDebug() << "数据库结构版本:" << current << "，升级到:" << latestVersion();
+    const QList<migrationstep> allSteps = steps();
+    for (const migrationstep &step : allSteps) {
+        if (step.version <= current) {
+            continue;
+        }
+        // 每一步连同版本记录在一个事务中完成（DM 的 DDL 会隐式提交，版本记录仍保证只在成功后写入）
+        if (!m_db.transaction()) {
+            m_lastError = QString("开启事务失败（版本 %1）: %2").arg(step.version).arg(m_db.lastError().text());
+            qDebug() << m_lastError;
+            return false;
+        }
+        if (!(this->*step.apply)()) {
+            m_lastError = QString("数据库结构升级失败（版本 %1，%2）: %3").arg(step.version).arg(step.description, m_lastError);
+            qDebug() << m_lastError;
+            m_db.rollback();
+            return false;
+        }
+        if (!recordVersion(step.version, step.description)) {
+            m_db.rollback();
+            return false;
+        }
+        if (!m_db.commit()) {
+            m_lastError = QString("提交事务失败（版本 %1）: %2").arg(step.version).arg(m_db.lastError().text());
+            qDebug() << m_lastError;
+            m_db.rollback();
+            return false;
+        }
+        qDebug() << "已升级数据库结构到版本" << step.version << step.description;
+    }
+    return true;
+}
+
+QString schemamigrator::getLastError() const
+{
+    return m_lastError;
+}
+
+bool schemamigrator::createVersionTable()
+{
+    return execDDL("CREATE TABLE IF NOT EXISTS SchemaVersion ("
+                   "version INT PRIMARY KEY, "
+                   "description VARCHAR(200), "
+                   "applied_at VARCHAR(32)"
+                   ")", true);
+}
+
+bool schemamigrator::createUserTable()
+{
+    // 用户表（包含role_type字段）
+    return execDDL("CREATE TABLE IF NOT EXISTS NowUsers ("
+                   + m_dialect->identityColumn("userid") + ", "
+                   "username VARCHAR(100) UNIQUE NOT NULL, "
+                   "password VARCHAR(255) NOT NULL, "
+                   "email VARCHAR(255), "
+                   "name VARCHAR(100), "
+                   "role_type INT DEFAULT 2"
+                   ")", true);
+}
+
+bool schemamigrator::addPermVersionColumn()
+{
+    // 权限版本号原用于权限缓存失效，已由版本 11 删除；新数据库不再创建该列，保留该步骤以维持版本顺序
+    return true;
+}
+
+bool schemamigrator::createPermissionsTable()
+{
+    return execDDL("CREATE TABLE IF NOT EXISTS NowUsersPermissions ("
+                   + m_dialect->identityColumn("permissionid") + ", "
+                   "userid INT NOT NULL, "
+                   "function_id INT NOT NULL, "
+                   "enabled INT DEFAULT 0, "
+                   "FOREIGN KEY (userid) REFERENCES NowUsers(userid) ON DELETE CASCADE, "
+                   "UNIQUE(userid, function_id)"
+                   ")", true);
+}
+
+bool schemamigrator::createPermissionIndexes()
+{
+    // 按用户读取已启用功能（登录、权限查询）
+    return execDDL(m_dialect->createIndex("idx_perm_user_enabled", "NowUsersPermissions",
+                                          QStringList() << "userid" << "enabled" << "function_id"), true);
+}
+
+bool schemamigrator::createHotPathIndexes()
+{
+    return applyIndexChanges(7);
+}
+
+//功能权限位掩码（见 functionregistry），由已有的权限行回填
+bool schemamigrator::addPermMaskColumn()
+{
+    if (!execDDL("ALTER TABLE NowUsers ADD perm_mask BIGINT DEFAULT 0", true)) {
+        return false;
+    }
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("UPDATE NowUsers SET perm_mask = %1").arg(functionregistry::maskSubquery("NowUsers.userid")))) {
+        m_lastError = QString("回填 perm_mask 失败: %1").arg(query.lastError().text());
+        return false;
+    }
+    return true;
+}
+
+bool schemamigrator::replaceLoginIndex()
+{
+    return applyIndexChanges(9);
+}
+
+//按索引目录创建或删除索引（已存在的跳过）
+bool schemamigrator::applyIndexChanges(int version)
+{
+    const QList<indexdef> indexes = indexcatalog::allIndexes();
+    for (const indexdef &index : indexes) {
+        if (index.retiredVersion == version &&
+            !execDDL(m_dialect->dropIndex(index.name, index.table), false)) {
+            m_lastError = QString("删除索引 %1 失败: %2").arg(index.name, m_lastError);
+            return false;
+        }
+    }
+    for (const indexdef &index : indexes) {
+        if (index.version == version &&
+            !execDDL(m_dialect->createIndex(index.name, index.table, index.columns), true)) {
+            m_lastError = QString("创建索引 %1 失败: %2").arg(index.name, m_lastError);
+            return false;
+        }
+    }
+    return true;
+}
+
+//功能目录（主页面按钮与权限矩阵的列），初始内容为内置功能，已有的跳过
+//order 是保留字，顺序列名为 sort_order
+bool schemamigrator::createFunctionsTable()
+{
+    if (!execDDL("CREATE TABLE IF NOT EXISTS Functions ("
+                 "id INT PRIMARY KEY, "
+                 "label VARCHAR(100) NOT NULL, "
+                 "subsystem INT DEFAULT 0, "
+                 "sort_order INT DEFAULT 0"
+                 ")", true)) {
+        return false;
+    }
+
+    QVariantList ids;
+    QVariantList labels;
+    QVariantList subsystems;
+    QVariantList orders;
+    for (int i = 0; i < functionregistry::COUNT; ++i) {
+        ids << functionregistry::FUNCTIONS[i].id;
+        labels << QString::fromUtf8(functionregistry::FUNCTIONS[i].label);
+        subsystems << 0;
+        orders << i;
+    }
+    QSqlQuery insertQuery(m_db);
+    insertQuery.prepare(m_dialect->insertIgnore("Functions",
+                                                QList<sqlcolumn>() << sqlcolumn{"id", "INT"}
+                                                                   << sqlcolumn{"label", "VARCHAR(100)"}
+                                                                   << sqlcolumn{"subsystem", "INT"}
+                                                                   << sqlcolumn{"sort_order", "INT"},
+                                                QStringList() << "id"));
+    insertQuery.addBindValue(ids);
+    insertQuery.addBindValue(labels);
+    insertQuery.addBindValue(subsystems);
+    insertQuery.addBindValue(orders);
+    if (!insertQuery.execBatch()) {
+        m_lastError = QString("初始化功能目录失败: %1").arg(insertQuery.lastError().text());
+        return false;
+    }
+    insertQuery.finish();
+    return true;
+}
+
+//删除旧版本数据库中不再读写的 perm_version 列（引用它的 idx_users_login 已在版本 9 删除）
+//新数据库没有该列，直接跳过；不支持 DROP COLUMN 的旧版 SQLite（3.35 之前）保留该列，不影响使用
+bool schemamigrator::dropPermVersionColumn()
+{
+    QSqlQuery probe(m_db);
+    const bool exists = probe.exec("SELECT perm_version FROM NowUsers WHERE 1 = 0");
+    probe.finish();
+    if (!exists) {
+        return true;
+    }
+    if (!execDDL("ALTER TABLE NowUsers DROP COLUMN perm_version", false)) {
+        qDebug() << "删除 perm_version 列失败，保留该列:" << m_lastError;
+        m_lastError.clear();
+    }
+    return true;
+}
+
+//初始化超级管理员 adminjmh 及其全部功能权限
+//用户与权限都用“冲突时跳过”的单条插入完成，重复执行不会报错，也无需先查询
+bool schemamigrator::seedAdmin()
+{
+    // 创建超级管理员，密码为adminjmh123（MD5加密）
+    QString passwordHash = QCryptographicHash::hash(QString("adminjmh123").toUtf8(), QCryptographicHash::Md5).toHex();
+    QSqlQuery insertAdminQuery(m_db);
+    insertAdminQuery.prepare(m_dialect->insertIgnore("NowUsers",
+                                                     QList<sqlcolumn>() << sqlcolumn{"username", "VARCHAR(100)"}
+                                                                        << sqlcolumn{"password", "VARCHAR(255)"}
+                                                                        << sqlcolumn{"email", "VARCHAR(255)"}
+                                                                        << sqlcolumn{"name", "VARCHAR(100)"}
+                                                                        << sqlcolumn{"role_type", "INT"},
+                                                     QStringList() << "username"));
+    insertAdminQuery.addBindValue("adminjmh");
+    insertAdminQuery.addBindValue(passwordHash);
+    insertAdminQuery.addBindValue("");
+    insertAdminQuery.addBindValue("超级管理员");
+    insertAdminQuery.addBindValue(1);  // role_type = 1 (admin)
+    if (!insertAdminQuery.exec()) {
+        m_lastError = QString("创建超级管理员失败: %1").arg(insertAdminQuery.lastError().text());
+        return false;
+    }
+    if (insertAdminQuery.numRowsAffected() > 0) {
+        qDebug() << "超级管理员adminjmh创建成功";
+    }
+    insertAdminQuery.finish();
+
+    // 为adminjmh补齐内置功能的权限（全部启用，已有的跳过；管理员按角色拥有目录中的全部功能）
+    QVariantList functionIds;
+    QVariantList usernames;
+    for (const functiondef &function : functionregistry::FUNCTIONS) {
+        functionIds << function.id;
+        usernames << "adminjmh";
+    }
+    QSqlQuery insertPermQuery(m_db);
+    insertPermQuery.prepare(m_dialect->insertIgnoreSelect("NowUsersPermissions",
+                                                          QStringList() << "userid" << "function_id" << "enabled",
+                                                          "SELECT userid, CAST(? AS INT) AS function_id, 1 AS enabled "
+                                                          "FROM NowUsers WHERE username = ?",
+                                                          QStringList() << "userid" << "function_id"));
+    insertPermQuery.addBindValue(functionIds);
+    insertPermQuery.addBindValue(usernames);
+    if (!insertPermQuery.execBatch()) {
+        m_lastError = QString("为adminjmh添加功能权限失败: %1").arg(insertPermQuery.lastError().text());
+        return false;
+    }
+    insertPermQuery.finish();
+    return true;
+}
+
+//执行 DDL
+bool schemamigrator::execDDL(const QString &sql, bool tolerateExisting)
+{
+    QSqlQuery query(m_db);
+    if (query.exec(sql)) {
+        return true;
+    }
+
+    if (tolerateExisting && m_dialect->isObjectExistsError(query.lastError())) {
+        qDebug() << "对象已存在，跳过:" << sql.left(60);
+        return true;
+    }
+    m_lastError = query.lastError().text();
+    return false;
+}
+
+//记录已完成的版本
+bool schemamigrator::recordVersion(int version, const QString &description)
+{
+    QSqlQuery query(m_db);
+    query.prepare("INSERT INTO SchemaVersion (version, description, applied_at) VALUES (?, ?, ?)");
+    query.addBindValue(version);
+    query.addBindValue(description);
+    query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+    if (!query.exec()) {
+        m_lastError = QString("记录数据库结构版本失败: %1").arg(query.lastError().text());
+        qDebug() << m_lastError;
+        return false;
+    }
+    query.finish();
+    return true;
+}
@@ -0,0 +1,68 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+#include <QSqlDatabase>
+#include <QString>
+#include <QList>
+
+class sqldialect;
+
+//数据库结构版本管理
+//SchemaVersion 表记录已执行的迁移步骤，启动时只需一次查询即可判断结构是否最新，
+//只有缺少的步骤才会执行
+class schemamigrator
+{
+public:
+    explicit schemamigrator(const QSqlDatabase &db);
+
+    //当前数据库结构版本（SchemaVersion 表不存在时为 0）
+    int currentVersion();
+
+    //程序要求的最新结构版本
+    static int latestVersion();
+
+    //执行缺少的迁移步骤
+    bool migrate();
+
+    //返回错误信息
+    QString getLastError() const;
+
+private:
+    typedef bool (schemamigrator::*migrationfunc)();
+
+    struct migrationstep
+    {
+        int version;
+        QString description;
+        migrationfunc apply;
+    };
+
+    static QList<migrationstep> steps();
+
+    //迁移步骤
+    bool createVersionTable();
+    bool createUserTable();
+    bool addPermVersionColumn();
+    bool createPermissionsTable();
+    bool createPermissionIndexes();
+    bool seedAdmin();
+    bool createHotPathIndexes();
+    bool addPermMaskColumn();
+    bool replaceLoginIndex();
+    bool createFunctionsTable();
+    bool dropPermVersionColumn();
+
+    //创建 version 版本新增的索引，删除该版本废弃的索引（见 indexcatalog）
+    bool applyIndexChanges(int version);
+
+    //执行 DDL；tolerateExisting 为 true 时把“对象已存在”视为成功（仅用于接管旧版本建立的数据库）
+    bool execDDL(const QString &sql, bool tolerateExisting);
+
+    //记录已完成的版本
+    bool recordVersion(int version, const QString &description);
+
+    QSqlDatabase m_db;
+    const sqldialect *m_dialect;  // 按连接的驱动选择
+    QString m_lastError;
+};
+
+#endif // SCHEMAMIGRATOR_H
@@ -0,0 +1,268 @@
+#include "sqldialect.h"
+#include <QSqlError>
+
+namespace {
+
+//SQLite：INSERT ... ON CONFLICT（3.24 起支持），LIMIT / OFFSET
+class sqlitedialect : public sqldialect
+{
+public:
+    QString name() const override
+    {
+        return "sqlite";
+    }
+
+    QString identityColumn(const QString &column) const override
+    {
+        return column + " INTEGER PRIMARY KEY AUTOINCREMENT";
+    }
+
+    QString createIndex(const QString &indexName, const QString &table, const QStringList &columns) const override
+    {
+        return QString("CREATE INDEX IF NOT EXISTS %1 ON %2 (%3)").arg(indexName, table, columnList(columns));
+    }
+
+    QString dropIndex(const QString &indexName, const QString &table) const override
+    {
+        Q_UNUSED(table)
+        return QString("DROP INDEX IF EXISTS %1").arg(indexName);
+    }
+
+    QString upsert(const QString &table, const QList<sqlcolumn> &keys, const QList<sqlcolumn> &values) const override
+    {
+        QStringList updates;
+        for (const sqlcolumn &column : values) {
+            updates << QString("%1 = excluded.%1").arg(column.name);
+        }
+        return QString("INSERT INTO %1 (%2) VALUES (%3) ON CONFLICT(%4) DO UPDATE SET %5")
+            .arg(table, columnList(columnNames(keys) + columnNames(values)), placeholders(keys.size() + values.size()),
+                 columnList(columnNames(keys)), updates.join(", "));
+    }
+
+    QString insertIgnore(const QString &table, const QList<sqlcolumn> &columns, const QStringList &conflictColumns) const override
+    {
+        return QString("INSERT INTO %1 (%2) VALUES (%3) ON CONFLICT(%4) DO NOTHING")
+            .arg(table, columnList(columnNames(columns)), placeholders(columns.size()), columnList(conflictColumns));
+    }
+
+    QString insertIgnoreSelect(const QString &table, const QStringList &columns,
+                               const QString &selectSql, const QStringList &conflictColumns) const override
+    {
+        // INSERT ... SELECT ... ON CONFLICT 需要 SELECT 带 WHERE 子句才能无歧义地解析
+        QString select = selectSql;
+        if (!select.contains(" WHERE ", Qt::CaseInsensitive)) {
+            select += " WHERE 1 = 1";
+        }
+        return QString("INSERT INTO %1 (%2) %3 ON CONFLICT(%4) DO NOTHING")
+            .arg(table, columnList(columns), select, columnList(conflictColumns));
+    }
+
+    QString limit(const QString &selectSql, int rows, int offset) const override
+    {
+        if (offset > 0) {
+            return QString("%1 LIMIT %2 OFFSET %3").arg(selectSql).arg(rows).arg(offset);
+        }
+        return QString("%1 LIMIT %2").arg(selectSql).arg(rows);
+    }
+
+    QString explain(const QString &sql) const override
+    {
+        return "EXPLAIN QUERY PLAN " + sql;
+    }
+
+    bool isFullScan(const QString &planLine) const override
+    {
+        // “SCAN t”为全表扫描；“SCAN t USING [COVERING] INDEX”为按索引顺序扫描
+        const QString line = planLine.trimmed();
+        return line.startsWith("SCAN ") && !line.contains(" USING ");
+    }
+
+    bool isObjectExistsError(const QSqlError &error) const override
+    {
+        // 重复建表/建索引与重复加列都返回 SQLITE_ERROR(1)，只能再按消息区分；
+        // 违反唯一约束是 SQLITE_CONSTRAINT，不会被当作“已存在”
+        if (error.nativeErrorCode() != "1") {
+            return false;
+        }
+        const QString text = error.databaseText();
+        return text.contains("already exists") || text.startsWith("duplicate column name");
+    }
+
+    bool isUniqueViolation(const QSqlError &error) const override
+    {
+        // SQLITE_CONSTRAINT(19) 也包括非空、外键等约束，再按消息确认是唯一约束；
+        // 驱动返回扩展错误码时为 SQLITE_CONSTRAINT_UNIQUE(2067) / SQLITE_CONSTRAINT_PRIMARYKEY(1555)
+        const QString code = error.nativeErrorCode();
+        if (code == "2067" || code == "1555") {
+            return true;
+        }
+        return code == "19" && error.databaseText().contains("UNIQUE constraint failed");
+    }
+};
+
+//达梦：MERGE INTO，SELECT TOP
+class dmdialect : public sqldialect
+{
+public:
+    QString name() const override
+    {
+        return "dm";
+    }
+
+    QString identityColumn(const QString &column) const override
+    {
+        return column + " INT PRIMARY KEY IDENTITY";
+    }
+
+    QString createIndex(const QString &indexName, const QString &table, const QStringList &columns) const override
+    {
+        return QString("CREATE INDEX %1 ON %2 (%3)").arg(indexName, table, columnList(columns));
+    }
+
+    QString dropIndex(const QString &indexName, const QString &table) const override
+    {
+        Q_UNUSED(table)
+        return QString("DROP INDEX %1").arg(indexName);
+    }
+
+    QString upsert(const QString &table, const QList<sqlcolumn> &keys, const QList<sqlcolumn> &values) const override
+    {
+        QStringList updates;
+        for (const sqlcolumn &column : values) {
+            updates << QString("t.%1 = s.%1").arg(column.name);
+        }
+        return QString("MERGE INTO %1 t USING (%2) s ON (%3) "
+                       "WHEN MATCHED THEN UPDATE SET %4 "
+                       "WHEN NOT MATCHED THEN INSERT (%5) VALUES (%6)")
+            .arg(table, sourceRow(keys + values), matchCondition(columnNames(keys)), updates.join(", "),
+                 columnList(columnNames(keys) + columnNames(values)), sourceColumns(columnNames(keys) + columnNames(values)));
+    }
+
+    QString insertIgnore(const QString &table, const QList<sqlcolumn> &columns, const QStringList &conflictColumns) const override
+    {
+        return QString("MERGE INTO %1 t USING (%2) s ON (%3) WHEN NOT MATCHED THEN INSERT (%4) VALUES (%5)")
+            .arg(table, sourceRow(columns), matchCondition(conflictColumns),
+                 columnList(columnNames(columns)), sourceColumns(columnNames(columns)));
+    }
+
+    QString insertIgnoreSelect(const QString &table, const QStringList &columns,
+                               const QString &selectSql, const QStringList &conflictColumns) const override
+    {
+        return QString("MERGE INTO %1 t USING (%2) s ON (%3) WHEN NOT MATCHED THEN INSERT (%4) VALUES (%5)")
+            .arg(table, selectSql, matchCondition(conflictColumns), columnList(columns), sourceColumns(columns));
+    }
+
+    QString limit(const QString &selectSql, int rows, int offset) const override
+    {
+        if (offset > 0) {
+            return QString("%1 LIMIT %2 OFFSET %3").arg(selectSql).arg(rows).arg(offset);
+        }
+        // 无偏移时使用 TOP，优化器可以在取到足够行后停止
+        QString sql = selectSql;
+        return sql.replace(0, 6, QString("SELECT TOP %1").arg(rows));
+    }
+
+    QString explain(const QString &sql) const override
+    {
+        return "EXPLAIN " + sql;
+    }
+
+    bool isFullScan(const QString &planLine) const override
+    {
+        // CSCN 为聚集索引（整表）扫描；索引查找为 SSEK / CSEK，按索引扫描为 SSCN
+        return planLine.contains("CSCN");
+    }
+
+    bool isObjectExistsError(const QSqlError &error) const override
+    {
+        // -2124：同名对象已存在（表、索引）；-2116：列已存在
+        const QString code = error.nativeErrorCode();
+        if (code == "-2124" || code == "-2116") {
+            return true;
+        }
+        // 部分 ODBC 驱动版本不返回原生错误码，此时只接受“已存在”类消息
+        return code.isEmpty() && (error.databaseText().contains("已存在") ||
+                                  error.databaseText().contains("already exists", Qt::CaseInsensitive));
+    }
+
+    bool isUniqueViolation(const QSqlError &error) const override
+    {
+        // -6602：违反唯一性约束（两个并发的 MERGE 都未匹配到已有行时，后插入的一方返回此错误）
+        const QString code = error.nativeErrorCode();
+        if (code == "-6602") {
+            return true;
+        }
+        return code.isEmpty() && (error.databaseText().contains("唯一性约束") ||
+                                  error.databaseText().contains("unique constraint", Qt::CaseInsensitive));
+    }
+
+private:
+    // 单行参数子查询：SELECT CAST(? AS INT) AS a, ... FROM DUAL
+    static QString sourceRow(const QList<sqlcolumn> &columns)
+    {
+        QStringList fields;
+        for (const sqlcolumn &column : columns) {
+            fields << QString("CAST(? AS %1) AS %2").arg(column.type, column.name);
+        }
+        return QString("SELECT %1 FROM DUAL").arg(fields.join(", "));
+    }
+
+    static QString matchCondition(const QStringList &columns)
+    {
+        QStringList conditions;
+        for (const QString &column : columns) {
+            conditions << QString("t.%1 = s.%1").arg(column);
+        }
+        return conditions.join(" AND ");
+    }
+
+    static QString sourceColumns(const QStringList &columns)
+    {
+        QStringList fields;
+        for (const QString &column : columns) {
+            fields << "s." + column;
+        }
+        return fields.join(", ");
+    }
+};
+
+}
+
+const sqldialect *sqldialect::forDbType(const QString &dbType)
+{
+    const QString type = dbType.trimmed().toUpper();
+    return forDriver(type == "SQLITE" || type == "QSQLITE" ? "QSQLITE" : "QODBC");
+}
+
+const sqldialect *sqldialect::forDriver(const QString &driverName)
+{
+    static const sqlitedialect sqlite;
+    static const dmdialect dm;
+    if (driverName == "QSQLITE") {
+        return &sqlite;
+    }
+    return &dm;
+}
+
+QString sqldialect::placeholders(int count)
+{
+    QStringList marks;
+    for (int i = 0; i < count; ++i) {
+        marks << "?";
+    }
+    return marks.join(", ");
+}
+
+QString sqldialect::columnList(const QStringList &columns)
+{
+    return columns.join(", ");
+}
+
+QStringList sqldialect::columnNames(const QList<sqlcolumn> &columns)
+{
+    QStringList names;
+    for (const sqlcolumn &column : columns) {
+        names << column.name;
+    }
+    return names;
+}
@@ -0,0 +1,70 @@
+#ifndef SQLDIALECT_H
+#define SQLDIALECT_H
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+class QSqlError;
+
+//语句中的一列及其参数类型（DM 的 MERGE 需要在 USING 子查询中显式转换参数类型）
+struct sqlcolumn
+{
+    QString name;
+    QString type = "INT";
+};
+
+//SQL 方言：按数据库类型生成原生语句，使写入路径都能用单条语句完成，而不是先查询再写入
+//生成的语句按参数出现顺序使用 ? 占位符；实例为只读的静态对象，可在多个线程中共享
+class sqldialect
+{
+public:
+    virtual ~sqldialect() = default;
+
+    //按配置文件中的数据库类型（DM / SQLITE）或 Qt 驱动名（QODBC / QSQLITE）选择方言，未知类型按 DM 处理
+    static const sqldialect *forDbType(const QString &dbType);
+    static const sqldialect *forDriver(const QString &driverName);
+
+    //方言名称（dm / sqlite）
+    virtual QString name() const = 0;
+
+    //自增主键列定义
+    virtual QString identityColumn(const QString &column) const = 0;
+
+    //创建索引（SQLite 使用 IF NOT EXISTS；DM 不支持，已存在时由 isObjectExistsError 识别）
+    virtual QString createIndex(const QString &indexName, const QString &table, const QStringList &columns) const = 0;
+
+    //删除索引（SQLite 使用 IF EXISTS）
+    virtual QString dropIndex(const QString &indexName, const QString &table) const = 0;
+
+    //插入或更新一行：参数顺序为 keys 之后接 values
+    virtual QString upsert(const QString &table, const QList<sqlcolumn> &keys, const QList<sqlcolumn> &values) const = 0;
+
+    //插入一行，conflictColumns 上已有相同值时不做任何操作（通过影响行数为 0 判断）
+    virtual QString insertIgnore(const QString &table, const QList<sqlcolumn> &columns, const QStringList &conflictColumns) const = 0;
+
+    //把子查询的结果插入表中，与已有行冲突的跳过；selectSql 的输出列名必须与 columns 一致
+    virtual QString insertIgnoreSelect(const QString &table, const QStringList &columns,
+                                       const QString &selectSql, const QStringList &conflictColumns) const = 0;
+
+    //限制查询返回的行数（selectSql 以 SELECT 开头且不含行数限制）
+    virtual QString limit(const QString &selectSql, int rows, int offset = 0) const = 0;
+
+    //查询计划语句（SQLite: EXPLAIN QUERY PLAN，DM: EXPLAIN）
+    virtual QString explain(const QString &sql) const = 0;
+
+    //查询计划中的一行是否为全表扫描
+    virtual bool isFullScan(const QString &planLine) const = 0;
+
+    //错误是否表示对象（表、列、索引）已存在（按原生错误码判断；违反唯一约束不算）
+    virtual bool isObjectExistsError(const QSqlError &error) const = 0;
+
+    //错误是否表示违反唯一约束（按原生错误码判断；并发写入同一键时 upsert/insertIgnore 可能返回此错误）
+    virtual bool isUniqueViolation(const QSqlError &error) const = 0;
+
+protected:
+    static QString placeholders(int count);
+    static QString columnList(const QStringList &columns);
+    static QStringList columnNames(const QList<sqlcolumn> &columns);
+};
+
+#endif // SQLDIALECT_H
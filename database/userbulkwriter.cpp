@@ -0,0 +1,161 @@
+#include "userbulkwriter.h"
+#include "../auth/functionregistry.h"
+#include <QSqlError>
+#include <QDebug>
+#include <utility>
+
+userbulkwriter::userbulkwriter(const QSqlDatabase &db)
+    : m_db(db)
+    , m_chunkSize(10000)
+    , m_writtenUsers(0)
+    , m_writtenPermissions(0)
+    , m_lastError("")
+{
+}
+
+userbulkwriter::~userbulkwriter()
+{
+    if (pendingCount() > 0) {
+        qDebug() << "批量写入器销毁时仍有" << pendingCount() << "个用户未写入";
+    }
+}
+
+void userbulkwriter::setChunkSize(int rows)
+{
+    m_chunkSize = qMax(1, rows);
+}
+
+int userbulkwriter::chunkSize() const
+{
+    return m_chunkSize;
+}
+
+bool userbulkwriter::append(const bulkuser &user)
+{
+    m_usernames << user.username;
+    m_passwords << user.passwordHash;
+    m_emails << user.email;
+    m_names << user.name;
+    m_roleTypes << user.roleType;
+    m_permMasks << qint64(functionregistry::fromList(user.enabledFunctions));
+    for (int functionId : user.enabledFunctions) {
+        m_permFunctions << functionId;
+        m_permUsernames << user.username;
+    }
+
+    if (m_usernames.size() >= m_chunkSize) {
+        return flush();
+    }
+    return true;
+}
+
+//在一个事务中写入缓存的用户及其权限
+bool userbulkwriter::flush()
+{
+    if (m_usernames.isEmpty()) {
+        return true;
+    }
+    if (!prepareQueries()) {
+        discard();
+        return false;
+    }
+
+    if (!m_db.transaction()) {
+        m_lastError = QString("开启事务失败: %1").arg(m_db.lastError().text());
+        discard();
+        return false;
+    }
+
+    m_userQuery->addBindValue(m_usernames);
+    m_userQuery->addBindValue(m_passwords);
+    m_userQuery->addBindValue(m_emails);
+    m_userQuery->addBindValue(m_names);
+    m_userQuery->addBindValue(m_roleTypes);
+    m_userQuery->addBindValue(m_permMasks);
+    bool ok = m_userQuery->execBatch();
+    if (!ok) {
+        m_lastError = QString("批量写入用户失败: %1").arg(m_userQuery->lastError().text());
+    }
+    m_userQuery->finish();
+
+    if (ok && !m_permFunctions.isEmpty()) {
+        m_permQuery->addBindValue(m_permFunctions);
+        m_permQuery->addBindValue(m_permUsernames);
+        ok = m_permQuery->execBatch();
+        if (!ok) {
+            m_lastError = QString("批量写入权限失败: %1").arg(m_permQuery->lastError().text());
+        }
+        m_permQuery->finish();
+    }
+
+    if (ok && !m_db.commit()) {
+        m_lastError = QString("提交事务失败: %1").arg(m_db.lastError().text());
+        ok = false;
+    }
+    if (!ok) {
+        m_db.rollback();
+        qDebug() << m_lastError;
+    } else {
+        m_writtenUsers += m_usernames.size();
+        m_writtenPermissions += m_permFunctions.size();
+    }
+    discard();
+    return ok;
+}
+
+void userbulkwriter::discard()
+{
+    m_usernames.clear();
+    m_passwords.clear();
+    m_emails.clear();
+    m_names.clear();
+    m_roleTypes.clear();
+    m_permMasks.clear();
+    m_permFunctions.clear();
+    m_permUsernames.clear();
+}
+
+qint64 userbulkwriter::writtenUsers() const
+{
+    return m_writtenUsers;
+}
+
+qint64 userbulkwriter::writtenPermissions() const
+{
+    return m_writtenPermissions;
+}
+
+int userbulkwriter::pendingCount() const
+{
+    return m_usernames.size();
+}
+
+QString userbulkwriter::getLastError() const
+{
+    return m_lastError;
+}
+
+//预编译插入语句（整个写入过程只 prepare 一次）
+bool userbulkwriter::prepareQueries()
+{
+    if (m_userQuery && m_permQuery) {
+        return true;
+    }
+
+    std::unique_ptr<QSqlQuery> userQuery(new QSqlQuery(m_db));
+    if (!userQuery->prepare("INSERT INTO NowUsers (username, password, email, name, role_type, perm_mask) VALUES (?, ?, ?, ?, ?, ?)")) {
+        m_lastError = QString("预编译用户插入语句失败: %1").arg(userQuery->lastError().text());
+        return false;
+    }
+
+    std::unique_ptr<QSqlQuery> permQuery(new QSqlQuery(m_db));
+    if (!permQuery->prepare("INSERT INTO NowUsersPermissions (userid, function_id, enabled) "
+                            "SELECT userid, CAST(? AS INT), 1 FROM NowUsers WHERE username = ?")) {
+        m_lastError = QString("预编译权限插入语句失败: %1").arg(permQuery->lastError().text());
+        return false;
+    }
+
+    m_userQuery = std::move(userQuery);
+    m_permQuery = std::move(permQuery);
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef USERBULKWRITER_H
+#define USERBULKWRITER_H
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QVariantList>
+#include <QList>
+#include <memory>
+
+//批量写入的一个用户（密码为已计算好的哈希）
+struct bulkuser
+{
+    QString username;
+    QString passwordHash;
+    QString email;
+    QString name;
+    int roleType = 2;
+    QList<int> enabledFunctions;   // 启用的功能编号
+};
+
+//用户批量写入器：缓存一批用户后用 execBatch 在一个事务中写入 NowUsers 与 NowUsersPermissions
+//用户行同时写入 perm_mask（由 enabledFunctions 计算），权限行通过用户名关联插入（INSERT ... SELECT），无需回读自增 userid，SQLite 与 DM 通用
+//调用方负责保证用户名不重复；一批中任一行失败则整批回滚
+class userbulkwriter
+{
+public:
+    explicit userbulkwriter(const QSqlDatabase &db);
+    ~userbulkwriter();
+
+    //每个事务写入的用户数（默认 10000）
+    void setChunkSize(int rows);
+    int chunkSize() const;
+
+    //加入一个用户，缓存满一批时自动写入
+    bool append(const bulkuser &user);
+
+    //写入缓存中剩余的用户
+    bool flush();
+
+    //丢弃缓存中尚未写入的用户
+    void discard();
+
+    //已提交的用户数与权限行数
+    qint64 writtenUsers() const;
+    qint64 writtenPermissions() const;
+
+    //当前缓存的用户数
+    int pendingCount() const;
+
+    QString getLastError() const;
+
+private:
+    Q_DISABLE_COPY(userbulkwriter)
+
+    bool prepareQueries();
+
+    QSqlDatabase m_db;
+    int m_chunkSize;
+    std::unique_ptr<QSqlQuery> m_userQuery;
+    std::unique_ptr<QSqlQuery> m_permQuery;
+
+    // 按列缓存（execBatch 的绑定方式）
+    QVariantList m_usernames;
+    QVariantList m_passwords;
+    QVariantList m_emails;
+    QVariantList m_names;
+    QVariantList m_roleTypes;
+    QVariantList m_permMasks;
+    QVariantList m_permFunctions;
+    QVariantList m_permUsernames;
+
+    qint64 m_writtenUsers;
+    qint64 m_writtenPermissions;
+    QString m_lastError;
+};
+
+#endif // USERBULKWRITER_H
@@ -1,4 +1,4 @@
-QT       += core gui sql
+QT       += core gui sql concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -8,29 +8,37 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+include(core.pri)
+
 SOURCES += \
-    auth/authmanager.cpp \
-    auth/userinfo.cpp \
-    config/configmanager.cpp\
-    database/databasemanager.cpp \
     widgets/loginwidget.cpp \
     main.cpp \
     widgets/maincontentwidget.cpp \
     mainwindow.cpp \
     widgets/registerwidget.cpp \
-    widgets/permissionmanagementwidget.cpp
+    widgets/permissionmanagementwidget.cpp \
+    widgets/permissionmatrixmodel.cpp \
+    widgets/permissioncheckdelegate.cpp \
+    widgets/userimportdialog.cpp \
+    widgets/backgroundimagecache.cpp \
+    widgets/apptheme.cpp \
+    metrics/startupmetrics.cpp \
+    metrics/rendermetrics.cpp
 
 
 HEADERS += \
-    auth/authmanager.h \
-    auth/userinfo.h \
-    config/configmanager.h \
-    database/databasemanager.h \
     widgets/loginwidget.h \
     widgets/maincontentwidget.h \
     mainwindow.h \
     widgets/registerwidget.h \
-    widgets/permissionmanagementwidget.h
+    widgets/permissionmanagementwidget.h \
+    widgets/permissionmatrixmodel.h \
+    widgets/permissioncheckdelegate.h \
+    widgets/userimportdialog.h \
+    widgets/backgroundimagecache.h \
+    widgets/apptheme.h \
+    metrics/startupmetrics.h \
+    metrics/rendermetrics.h
 
 
 
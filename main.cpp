@@ -1,4 +1,6 @@
 #include "mainwindow.h"
+#include "metrics/startupmetrics.h"
+#include "widgets/apptheme.h"
 
 #include <QApplication>
 
@@ -9,9 +11,14 @@ void showMessageBox(QWidget *parent);
 
 int main(int argc, char *argv[])
 {
+    startupmetrics::instance().start();
     QApplication a(argc, argv);
+    // 应用级样式表只设置一次，各页面不再单独编译样式
+    AppTheme::apply(&a);
+    startupmetrics::instance().mark("app_created");
     MainWindow w;
     w.show();
+    startupmetrics::instance().mark("window_shown");
     return a.exec();
 }
 
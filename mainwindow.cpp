@@ -10,7 +10,13 @@
 #include <QFile>
 #include <QDebug>
 #include <QMessageBox>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QTimer>
+#include <QElapsedTimer>
 #include "auth/userinfo.h"
+#include "metrics/startupmetrics.h"
+#include "metrics/rendermetrics.h"
 
 
 
@@ -20,7 +26,13 @@ MainWindow::MainWindow(QWidget *parent)
     , m_configManager(new configmanager())  // 创建配置管理器
     , dbManger(new databasemanager(m_configManager))  // 传入配置管理器
     , m_authManager(nullptr)
+    , m_backendWatcher(nullptr)
+    , m_backendReady(false)
+    , m_loginWidget(nullptr)
+    , m_registerWidget(nullptr)
+    , m_mainContentWidget(nullptr)
 {
+    startupmetrics::instance().mark("config_loaded");
     this->setWindowTitle("登录");
     
     // 先初始化UI，确保界面能显示
@@ -30,21 +42,6 @@ MainWindow::MainWindow(QWidget *parent)
     this->resize(880, 640);
     this->setMinimumSize(880, 640);
     
-    // 连接数据库
-    bool dbConnected = false;
-    if (!dbManger->connectDatabase()) {
-        QString errorMsg = QString("数据库连接失败：%1\n\n请检查：\n1. 数据库服务是否运行\n2. 配置文件 config.ini 中的数据库配置是否正确").arg(dbManger->getLastError());
-        QMessageBox::warning(this, "数据库连接失败", errorMsg);
-    } else {
-        // 初始化用户表
-        if (!dbManger->initUserTable()) {
-            QString errorMsg = QString("用户表初始化失败：%1").arg(dbManger->getLastError());
-            QMessageBox::warning(this, "用户表初始化失败", errorMsg);
-        } else {
-            dbConnected = true;
-        }
-    }
-    
     // 创建认证管理器（即使数据库未连接也创建，但功能会受限）
     m_authManager = new AuthManager(dbManger);
     
@@ -53,56 +50,164 @@ MainWindow::MainWindow(QWidget *parent)
 
     //调用建立槽函数连接
     connections();
+
+    // 数据库连接与结构迁移在后台进行，窗口先显示
+    // 首帧与后台任务都完成后输出一行启动耗时（startup_metrics ...）
+    startupmetrics::instance().markOnFirstPaint(m_loginWidget, "time_to_first_frame");
+    startupmetrics::instance().reportWhenReached(QStringList() << "time_to_first_frame" << "backend_done");
+    startBackend();
+
+    // 登录页显示后在空闲时预热其余页面（config.ini [UI] PrewarmPages）
+    if (m_configManager->getPrewarmPages()) {
+        QTimer::singleShot(m_configManager->getPrewarmDelay(), this, &MainWindow::prewarmPages);
+    }
+    startupmetrics::instance().mark("window_constructed");
 }
 
 MainWindow::~MainWindow()
 {
+    // 等待后台连接任务结束（中止重试等待），避免其访问已销毁的数据库管理器
+    if (m_backendWatcher) {
+        dbManger->abortOpenBackend();
+        m_backendWatcher->waitForFinished();
+    }
+    // 输出各页面的绘制耗时统计
+    rendermetrics::instance().report();
     delete m_authManager;   // 删除认证管理器
     delete dbManger;        // 删除数据库管理器
     delete m_configManager; // 删除配置管理器
     delete m_stackedWidget;
 }
 
+void MainWindow::startBackend()
+{
+    m_backendReady = false;
+    m_loginWidget->setBackendReady(false, "正在连接数据库…");
+
+    m_backendWatcher = new QFutureWatcher<startupresult>(this);
+    connect(m_backendWatcher, &QFutureWatcher<startupresult>::finished, this, [this]() {
+        const startupresult result = m_backendWatcher->result();
+        if (result.ready) {
+            startupmetrics::instance().mark("time_to_ready");
+        }
+        startupmetrics::instance().mark("backend_done");
+
+        if (result.ready) {
+            m_backendReady = true;
+            m_loginWidget->setBackendReady(true);
+        } else if (!result.connected) {
+            m_loginWidget->setBackendReady(false, "数据库不可用");
+            QString errorMsg = QString("数据库连接失败（已尝试 %1 次）：%2\n\n请检查：\n1. 数据库服务是否运行\n2. 配置文件 config.ini 中的数据库配置是否正确").arg(result.attempts).arg(result.error);
+            QMessageBox::warning(this, "数据库连接失败", errorMsg);
+        } else {
+            m_loginWidget->setBackendReady(false, "数据库初始化失败");
+            QString errorMsg = QString("用户表初始化失败：%1").arg(result.error);
+            QMessageBox::warning(this, "用户表初始化失败", errorMsg);
+        }
+    });
+
+    databasemanager *dbManager = dbManger;
+    m_backendWatcher->setFuture(QtConcurrent::run([dbManager]() {
+        return dbManager->openBackend();
+    }));
+}
+
 void MainWindow::initUI()
 {
     // 1. 创建堆叠窗口
     m_stackedWidget = new QStackedWidget(this);  // ← 创建，this作为父对象
     
-    // 2. 创建三个页面
+    // 2. 只创建登录页面；注册页与主内容页在第一次进入时创建（或在空闲时预热）
     m_loginWidget = new LoginWidget(m_stackedWidget);
-    m_registerWidget = new RegisterWidget(m_stackedWidget);
-    m_mainContentWidget = new MainContentWidget(m_stackedWidget);
-    
-    // 3. 将页面添加到堆叠窗口
-    m_stackedWidget->addWidget(m_loginWidget);        // 索引0
-    m_stackedWidget->addWidget(m_registerWidget);     // 索引1
-    m_stackedWidget->addWidget(m_mainContentWidget);   // 索引2
+    m_stackedWidget->addWidget(m_loginWidget);
     
-    // 4. 设置堆叠窗口为中央部件（重要！）
+    // 3. 设置堆叠窗口为中央部件（重要！）
     setCentralWidget(m_stackedWidget);  // ← 这样QStackedWidget才会显示
     
-    // 5. 默认显示登录页面
-    m_stackedWidget->setCurrentIndex(0);
+    // 4. 默认显示登录页面
+    m_stackedWidget->setCurrentWidget(m_loginWidget);
+    startupmetrics::instance().mark("login_page_built");
+}
+
+//获取注册页面（第一次调用时创建）
+RegisterWidget *MainWindow::registerPage()
+{
+    if (!m_registerWidget) {
+        QElapsedTimer timer;
+        timer.start();
+        m_registerWidget = new RegisterWidget(m_stackedWidget);
+        m_stackedWidget->addWidget(m_registerWidget);
+        connectRegisterPage();
+        qDebug() << "注册页面创建耗时(ms):" << timer.elapsed();
+        startupmetrics::instance().mark("register_page_built");
+    }
+    return m_registerWidget;
+}
+
+//获取主内容页面（第一次调用时创建）
+MainContentWidget *MainWindow::mainContentPage()
+{
+    if (!m_mainContentWidget) {
+        QElapsedTimer timer;
+        timer.start();
+        m_mainContentWidget = new MainContentWidget(m_stackedWidget);
+        m_stackedWidget->addWidget(m_mainContentWidget);
+        connectMainContentPage();
+        qDebug() << "主内容页面创建耗时(ms):" << timer.elapsed();
+        startupmetrics::instance().mark("main_page_built");
+    }
+    return m_mainContentWidget;
+}
+
+//空闲时预热尚未创建的页面，每次事件循环只创建一个，避免阻塞输入
+void MainWindow::prewarmPages()
+{
+    if (!m_registerWidget) {
+        registerPage();
+        QTimer::singleShot(0, this, &MainWindow::prewarmPages);
+    } else if (!m_mainContentWidget) {
+        mainContentPage();
+    }
+}
+
+//显示登录页面
+void MainWindow::showLoginPage()
+{
+    m_stackedWidget->setCurrentWidget(m_loginWidget);
+    this->setWindowTitle("登录");
 }
 
 void MainWindow::connections()
 {
     //当收到登陆界面的注册按钮点击后发出的切换到注册界面信号
     connect(m_loginWidget, &LoginWidget::changeToRegister, this, [this](){
-        m_stackedWidget->setCurrentIndex(1);
+        m_stackedWidget->setCurrentWidget(registerPage());
         this->setWindowTitle("注册");
     });
 
     //连接登录成功信号
-    connect(m_loginWidget, &LoginWidget::loginSuccess, this, [this](const QString &username){
-        // 根据用户权限更新主界面按钮状态
-        m_mainContentWidget->updateButtonsByPermissions(m_authManager, username);
+    connect(m_loginWidget, &LoginWidget::loginSuccess, this, [this](const usersession &session){
+        // 保存登录会话，后续不再按用户名重新查询
+        m_session = session;
+
+        // 根据会话中的权限更新主界面按钮状态
+        MainContentWidget *mainPage = mainContentPage();
+        mainPage->setSession(m_authManager, m_session);
         
         // 切换到主内容页面
-        m_stackedWidget->setCurrentIndex(2);  // 索引2是主内容页面
-        this->setWindowTitle(QString("欢迎，%1").arg(username));
+        m_stackedWidget->setCurrentWidget(mainPage);
+        this->setWindowTitle(QString("欢迎，%1").arg(m_session.username));
     });
-    
+
+    //连接登录失败信号
+    connect(m_loginWidget, &LoginWidget::loginFailed, this, [](const QString &errorMessage){
+        // LoginWidget 内部已经显示了错误信息，这里不再重复显示
+    });
+}
+
+//主内容页面的信号连接（页面创建时调用）
+void MainWindow::connectMainContentPage()
+{
     // 连接权限管理请求信号
     connect(m_mainContentWidget, &MainContentWidget::permissionManagementRequested, this, [this](){
         // 打开权限管理对话框
@@ -110,30 +215,37 @@ void MainWindow::connections()
         permWidget->setAttribute(Qt::WA_DeleteOnClose);
         permWidget->exec();
         
-        // 权限更新后，刷新主界面按钮显示
-        // 重新获取当前用户名并更新按钮状态
-        // 这里需要从登录信息中获取，暂时使用adminjmh（因为只有管理员能打开这个对话框）
-        m_mainContentWidget->updateButtonsByPermissions(m_authManager, "adminjmh");
+        // 权限更新后，按当前会话的用户刷新主界面按钮显示
+        m_mainContentWidget->updateButtonsByPermissions(m_authManager, m_session);
+    });
+
+    // 连接批量导入请求信号
+    connect(m_mainContentWidget, &MainContentWidget::userImportRequested, this, [this](){
+        UserImportDialog *importDialog = new UserImportDialog(m_authManager, this);
+        importDialog->setAttribute(Qt::WA_DeleteOnClose);
+        importDialog->exec();
     });
     
     // 连接退出登录信号
     connect(m_mainContentWidget, &MainContentWidget::logoutRequested, this, [this](){
+        // 取消尚未返回的数据库请求
+        m_mainContentWidget->cancelPendingRequests();
+        m_loginWidget->cancelPendingRequests();
+        // 清除登录会话
+        m_session = usersession();
         // 清空登录界面的输入框
         m_loginWidget->clearInputFields();
         // 切换到登录页面
-        m_stackedWidget->setCurrentIndex(0);
-        this->setWindowTitle("登录");
-    });
-
-    //连接登录失败信号
-    connect(m_loginWidget, &LoginWidget::loginFailed, this, [](const QString &errorMessage){
-        // LoginWidget 内部已经显示了错误信息，这里不再重复显示
+        showLoginPage();
     });
+}
 
+//注册页面的信号连接（页面创建时调用）
+void MainWindow::connectRegisterPage()
+{
     //当收到注册界面的返回按钮点击后发出的切换到登录界面信号
     connect(m_registerWidget, &RegisterWidget::backToLogin, this, [this](){
-        m_stackedWidget->setCurrentIndex(0);
-        this->setWindowTitle("登录");
+        showLoginPage();
     });
 
     //连接注册请求信号
@@ -143,35 +255,36 @@ void MainWindow::connections()
             QMessageBox::warning(this, "错误", "认证管理器未初始化！");
             return;
         }
+        if (!m_backendReady) {
+            QMessageBox::warning(this, "注册失败", "数据库尚未连接，请稍后再试！");
+            return;
+        }
         
         // 创建 UserInfo 对象
         userinfo user;
         user.setUserData(data);
         
-        // 检查用户名是否已存在
-        if (m_authManager->userExists(user.getUserData().username)) {
-            QMessageBox::warning(this, "注册失败", "用户名已存在，请选择其他用户名！");
-            return;
-        }
-        
-        // 尝试注册用户
-        if (m_authManager->registerUser(user)) {
-            QMessageBox::information(this, "注册成功", "注册成功，请返回登录！");
-            // 清空注册界面的输入框
-            m_registerWidget->clearInputFields();
-            // 切换到登录页面
-            m_stackedWidget->setCurrentIndex(0);
-            this->setWindowTitle("登录");
-        } else {
-            // 显示错误信息
-            QString errorMsg = m_authManager->getLastError();
-            QMessageBox::warning(this, "注册失败", errorMsg);
-        }
-    });
+        // 在数据库线程中异步注册（注册过程中会检查用户名是否已存在）
+        m_registerWidget->setBusy(true);
+        QFutureWatcher<authresult> *watcher = new QFutureWatcher<authresult>(this);
+        connect(watcher, &QFutureWatcher<authresult>::finished, this, [this, watcher]() {
+            watcher->deleteLater();
+            m_registerWidget->setBusy(false);
 
+            const authresult result = watcher->result();
+            if (result.success) {
+                QMessageBox::information(this, "注册成功", "注册成功，请返回登录！");
+                // 清空注册界面的输入框
+                m_registerWidget->clearInputFields();
+                // 切换到登录页面
+                showLoginPage();
+            } else if (result.error == "用户名已存在") {
+                QMessageBox::warning(this, "注册失败", "用户名已存在，请选择其他用户名！");
+            } else {
+                // 显示错误信息
+                QMessageBox::warning(this, "注册失败", result.error);
+            }
+        });
+        watcher->setFuture(m_authManager->registerUserAsync(user));
+    });
 }
-
-
-
-
-
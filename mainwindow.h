@@ -4,6 +4,7 @@
 #include <QMainWindow>
 #include <QPushButton>
 #include <QStackedWidget>
+#include <QFutureWatcher>
 #include "database/databasemanager.h"
 #include "config/configmanager.h"
 #include "auth/authmanager.h"
@@ -11,6 +12,7 @@
 #include "widgets/registerwidget.h"
 #include "widgets/maincontentwidget.h"
 #include "widgets/permissionmanagementwidget.h"
+#include "widgets/userimportdialog.h"
 
 
 
@@ -29,6 +31,21 @@ public:
     //建立槽函数连接
     void connections();
 
+    //在后台线程连接数据库并迁移结构，完成后启用登录
+    void startBackend();
+
+private:
+    //注册页与主内容页按需创建（第一次进入时），创建时建立各自的信号连接
+    RegisterWidget *registerPage();
+    MainContentWidget *mainContentPage();
+    void connectRegisterPage();
+    void connectMainContentPage();
+
+    //空闲时预热尚未创建的页面
+    void prewarmPages();
+
+    void showLoginPage();
+
 
 
 private:
@@ -36,11 +53,16 @@ private:
     configmanager *m_configManager;  // 配置管理器
     databasemanager *dbManger;       // 数据库管理器
     AuthManager *m_authManager;      // 认证管理器
+    QFutureWatcher<startupresult> *m_backendWatcher;  // 后台连接任务
+    bool m_backendReady;             // 数据库已连接且结构迁移完成
 
     // 堆叠窗口（页面容器）
     QStackedWidget *m_stackedWidget;  
 
-    // 具体页面
+    // 当前登录会话
+    usersession m_session;
+
+    // 具体页面（注册页与主内容页未创建时为 nullptr）
     LoginWidget *m_loginWidget;
     RegisterWidget *m_registerWidget;
     MainContentWidget *m_mainContentWidget;
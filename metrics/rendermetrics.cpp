@@ -0,0 +1,59 @@
+#include "rendermetrics.h"
+#include <QDebug>
+
+double renderstats::averageMs() const
+{
+    return frames > 0 ? totalNs / 1e6 / frames : 0.0;
+}
+
+rendermetrics &rendermetrics::instance()
+{
+    static rendermetrics metrics;
+    return metrics;
+}
+
+void rendermetrics::record(const QString &page, qint64 nsecs)
+{
+    renderstats &entry = m_stats[page];
+    ++entry.frames;
+    entry.totalNs += nsecs;
+    entry.maxNs = qMax(entry.maxNs, nsecs);
+}
+
+renderstats rendermetrics::stats(const QString &page) const
+{
+    return m_stats.value(page);
+}
+
+QMap<QString, renderstats> rendermetrics::allStats() const
+{
+    return m_stats;
+}
+
+void rendermetrics::reset()
+{
+    m_stats.clear();
+}
+
+void rendermetrics::report() const
+{
+    for (auto it = m_stats.cbegin(); it != m_stats.cend(); ++it) {
+        qDebug().noquote() << QString("render_metrics page=%1 frames=%2 avg_ms=%3 max_ms=%4")
+                                  .arg(it.key())
+                                  .arg(it.value().frames)
+                                  .arg(it.value().averageMs(), 0, 'f', 3)
+                                  .arg(it.value().maxNs / 1e6, 0, 'f', 3);
+    }
+}
+
+
+painttimer::painttimer(const char *page)
+    : m_page(page)
+{
+    m_timer.start();
+}
+
+painttimer::~painttimer()
+{
+    rendermetrics::instance().record(QString::fromLatin1(m_page), m_timer.nsecsElapsed());
+}
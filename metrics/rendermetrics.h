@@ -0,0 +1,54 @@
+#ifndef RENDERMETRICS_H
+#define RENDERMETRICS_H
+#include <QString>
+#include <QMap>
+#include <QElapsedTimer>
+
+//单个页面的绘制耗时统计
+struct renderstats
+{
+    qint64 frames = 0;     // paintEvent 次数
+    qint64 totalNs = 0;    // 累计耗时
+    qint64 maxNs = 0;      // 单帧最大耗时
+
+    double averageMs() const;
+};
+
+//页面绘制耗时计数器（按页面名称统计每帧 paintEvent 的耗时），仅在界面线程使用
+class rendermetrics
+{
+public:
+    static rendermetrics &instance();
+
+    //记录一帧的绘制耗时
+    void record(const QString &page, qint64 nsecs);
+
+    renderstats stats(const QString &page) const;
+    QMap<QString, renderstats> allStats() const;
+    void reset();
+
+    //每个页面输出一行：render_metrics page=login frames=.. avg_ms=.. max_ms=..
+    void report() const;
+
+private:
+    rendermetrics() = default;
+    Q_DISABLE_COPY(rendermetrics)
+
+    QMap<QString, renderstats> m_stats;
+};
+
+//RAII 计时：构造时开始，析构时记录到 rendermetrics
+class painttimer
+{
+public:
+    explicit painttimer(const char *page);
+    ~painttimer();
+
+private:
+    Q_DISABLE_COPY(painttimer)
+
+    const char *m_page;
+    QElapsedTimer m_timer;
+};
+
+#endif // RENDERMETRICS_H
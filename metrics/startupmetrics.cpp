@@ -0,0 +1,129 @@
+#include "startupmetrics.h"
+#include <QWidget>
+#include <QEvent>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QDebug>
+#include <utility>
+
+namespace {
+//首次绘制监听：收到第一个 Paint 事件后记录阶段并移除自身
+class firstpaintfilter : public QObject
+{
+public:
+    firstpaintfilter(const QString &phase, QObject *parent)
+        : QObject(parent)
+        , m_phase(phase)
+    {
+    }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::Paint) {
+            startupmetrics::instance().mark(m_phase);
+            watched->removeEventFilter(this);
+            deleteLater();
+        }
+        return false;
+    }
+
+private:
+    QString m_phase;
+};
+}
+
+startupmetrics::startupmetrics()
+{
+    m_clock.start();
+}
+
+startupmetrics &startupmetrics::instance()
+{
+    static startupmetrics metrics;
+    return metrics;
+}
+
+void startupmetrics::start()
+{
+    QMutexLocker locker(&m_mutex);
+    m_clock.restart();
+    m_phases.clear();
+    m_reportPhases.clear();
+}
+
+void startupmetrics::mark(const QString &phase)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const QPair<QString, qint64> &entry : std::as_const(m_phases)) {
+            if (entry.first == phase) {
+                return;
+            }
+        }
+        m_phases.append(qMakePair(phase, m_clock.elapsed()));
+        if (!m_reportPhases.removeOne(phase) || !m_reportPhases.isEmpty()) {
+            return;
+        }
+    }
+    report();
+}
+
+qint64 startupmetrics::elapsed(const QString &phase) const
+{
+    QMutexLocker locker(&m_mutex);
+    for (const QPair<QString, qint64> &entry : m_phases) {
+        if (entry.first == phase) {
+            return entry.second;
+        }
+    }
+    return -1;
+}
+
+QList<QPair<QString, qint64>> startupmetrics::phases() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_phases;
+}
+
+void startupmetrics::markOnFirstPaint(QWidget *widget, const QString &phase)
+{
+    if (!widget) {
+        return;
+    }
+    widget->installEventFilter(new firstpaintfilter(phase, widget));
+}
+
+void startupmetrics::report() const
+{
+    QStringList fields;
+    const QList<QPair<QString, qint64>> recorded = phases();
+    for (const QPair<QString, qint64> &entry : recorded) {
+        fields << QString("%1=%2").arg(entry.first).arg(entry.second);
+    }
+    qDebug().noquote() << "startup_metrics" << fields.join(' ');
+}
+
+void startupmetrics::reportWhenReached(const QStringList &phases)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_reportPhases.clear();
+        for (const QString &phase : phases) {
+            bool reached = false;
+            for (const QPair<QString, qint64> &entry : std::as_const(m_phases)) {
+                if (entry.first == phase) {
+                    reached = true;
+                    break;
+                }
+            }
+            if (!reached) {
+                m_reportPhases.append(phase);
+            }
+        }
+        if (!m_reportPhases.isEmpty()) {
+            return;
+        }
+    }
+    report();
+}
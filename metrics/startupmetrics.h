@@ -0,0 +1,50 @@
+#ifndef STARTUPMETRICS_H
+#define STARTUPMETRICS_H
+#include <QString>
+#include <QList>
+#include <QPair>
+#include <QStringList>
+#include <QMutex>
+#include <QElapsedTimer>
+
+class QWidget;
+
+//启动阶段计时（自 main() 开始计时，单位毫秒）
+//各阶段只记录第一次到达的时间，report() 以固定格式输出，便于监控脚本采集
+class startupmetrics
+{
+public:
+    static startupmetrics &instance();
+
+    //开始计时（在 main() 最开始调用）
+    void start();
+
+    //记录阶段到达时间（同名阶段只记录第一次），可在任意线程调用
+    void mark(const QString &phase);
+
+    //阶段到达时间，未记录时返回 -1
+    qint64 elapsed(const QString &phase) const;
+
+    //按记录顺序返回所有阶段
+    QList<QPair<QString, qint64>> phases() const;
+
+    //在控件第一次绘制时记录阶段（用于首帧时间）
+    void markOnFirstPaint(QWidget *widget, const QString &phase);
+
+    //输出一行汇总：startup_metrics window_shown=.. time_to_first_frame=..
+    void report() const;
+
+    //所有指定阶段都已记录后自动输出一次汇总（阶段到达顺序不确定时使用）
+    void reportWhenReached(const QStringList &phases);
+
+private:
+    startupmetrics();
+    Q_DISABLE_COPY(startupmetrics)
+
+    mutable QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QList<QPair<QString, qint64>> m_phases;
+    QStringList m_reportPhases;
+};
+
+#endif // STARTUPMETRICS_H
@@ -0,0 +1,13 @@
+# 测试数据生成工具：批量生成用户与权限（SQLite / DM）
+QT       += core sql concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = learn1_datagen
+
+include(../../core.pri)
+
+SOURCES += \
+    main.cpp
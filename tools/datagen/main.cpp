@@ -0,0 +1,152 @@
+#include "../../config/configmanager.h"
+#include "../../database/databasemanager.h"
+#include "../../database/userbulkwriter.h"
+#include "../../auth/authmanager.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QSqlQuery>
+
+//用法：learn1_datagen --users 1000000 [--config config.ini] [--prefix gen] [--start 1]
+//                     [--chunk 50000] [--probabilities 0.9,0.5,0.5,0.2,0.05] [--password Passw0rd] [--seed 1]
+//--probabilities 按功能目录（Functions 表）的顺序给出，个数须与目录中的功能数一致
+//按 config.ini 的 [Database] 连接数据库（SQLite 或 DM），先执行结构迁移，再批量写入用户与权限
+//生成的用户名为 <prefix><序号，7 位补零>，所有用户使用同一个密码
+
+namespace {
+
+//解析每个功能被启用的概率（按功能目录的顺序）
+bool parseProbabilities(const QString &text, int count, QList<double> *probabilities)
+{
+    const QStringList parts = text.split(',', Qt::SkipEmptyParts);
+    if (parts.size() != count) {
+        return false;
+    }
+    for (const QString &part : parts) {
+        bool ok = false;
+        const double value = part.trimmed().toDouble(&ok);
+        if (!ok || value < 0.0 || value > 1.0) {
+            return false;
+        }
+        probabilities->append(value);
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("批量生成测试用户与权限数据");
+    parser.addHelpOption();
+    QCommandLineOption configOption("config", "配置文件路径（默认按程序目录查找 config.ini）", "path");
+    QCommandLineOption usersOption("users", "生成的用户数", "count");
+    QCommandLineOption prefixOption("prefix", "用户名前缀", "text", "gen");
+    QCommandLineOption startOption("start", "起始序号（续写已有数据时使用）", "index", "1");
+    QCommandLineOption chunkOption("chunk", "每个事务写入的用户数", "rows", "50000");
+    QCommandLineOption probabilitiesOption("probabilities", "功能目录中每个功能各自被启用的概率，逗号分隔（默认均为 0.5）", "list");
+    QCommandLineOption passwordOption("password", "所有生成用户的明文密码", "text", "Passw0rd");
+    QCommandLineOption seedOption("seed", "随机数种子", "number", "1");
+    parser.addOptions({configOption, usersOption, prefixOption, startOption, chunkOption,
+                       probabilitiesOption, passwordOption, seedOption});
+    parser.process(app);
+
+    const int userCount = parser.value(usersOption).toInt();
+    const int start = parser.value(startOption).toInt();
+    if (userCount <= 0 || start <= 0) {
+        err << "请用 --users 指定大于 0 的用户数，--start 必须大于 0" << Qt::endl;
+        return 2;
+    }
+    // 连接数据库并确保表结构存在
+    configmanager config;
+    if (parser.isSet(configOption) && !config.initConfigManager(parser.value(configOption))) {
+        err << "读取配置文件失败: " << parser.value(configOption) << Qt::endl;
+        return 1;
+    }
+    databasemanager dbManager(&config);
+    if (!dbManager.connectDatabase() || !dbManager.migrateSchema()) {
+        err << dbManager.getLastError() << Qt::endl;
+        return 1;
+    }
+
+    // 概率个数与功能目录一致
+    const functioncatalog catalog = dbManager.getFunctionCatalog();
+    QList<double> probabilities;
+    if (!parser.isSet(probabilitiesOption)) {
+        for (int f = 0; f < catalog.count(); ++f) {
+            probabilities << 0.5;
+        }
+    } else if (!parseProbabilities(parser.value(probabilitiesOption), catalog.count(), &probabilities)) {
+        err << "--probabilities 需要 " << catalog.count() << " 个 0 到 1 之间的数" << Qt::endl;
+        return 2;
+    }
+
+    connectionguard conn(dbManager.getConnectionPool());
+    if (!conn.isValid()) {
+        err << "获取数据库连接失败: " << dbManager.getConnectionPool()->getLastError() << Qt::endl;
+        return 1;
+    }
+
+    // 提前检查首个用户名，避免写到一半才因重复失败
+    const QString prefix = parser.value(prefixOption);
+    {
+        QSqlQuery check(conn.database());
+        check.prepare("SELECT COUNT(*) FROM NowUsers WHERE username = ?");
+        check.addBindValue(QString("%1%2").arg(prefix).arg(start, 7, 10, QChar('0')));
+        if (check.exec() && check.next() && check.value(0).toInt() > 0) {
+            err << "用户名已存在，请更换 --prefix 或调整 --start" << Qt::endl;
+            return 1;
+        }
+    }
+
+    userbulkwriter writer(conn.database());
+    writer.setChunkSize(parser.value(chunkOption).toInt());
+
+    // 所有用户使用同一个密码，哈希只计算一次
+    const QString passwordHash = AuthManager::hashPassword(parser.value(passwordOption));
+    QRandomGenerator random(parser.value(seedOption).toUInt());
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 lastReported = 0;
+    for (int i = start; i < start + userCount; ++i) {
+        bulkuser user;
+        user.username = QString("%1%2").arg(prefix).arg(i, 7, 10, QChar('0'));
+        user.passwordHash = passwordHash;
+        user.email = user.username + "@example.com";
+        user.name = user.username;
+        for (int f = 0; f < catalog.count(); ++f) {
+            if (random.generateDouble() < probabilities.at(f)) {
+                user.enabledFunctions.append(catalog.functions().at(f).id);
+            }
+        }
+
+        if (!writer.append(user)) {
+            err << writer.getLastError() << Qt::endl;
+            return 1;
+        }
+        if (writer.writtenUsers() != lastReported) {
+            lastReported = writer.writtenUsers();
+            const double seconds = timer.elapsed() / 1000.0;
+            out << "已写入 " << lastReported << "/" << userCount << " 个用户（"
+                << qRound(seconds > 0 ? lastReported / seconds : 0.0) << " 用户/秒）" << Qt::endl;
+        }
+    }
+    if (!writer.flush()) {
+        err << writer.getLastError() << Qt::endl;
+        return 1;
+    }
+
+    const double seconds = timer.elapsed() / 1000.0;
+    out << "完成：" << writer.writtenUsers() << " 个用户，" << writer.writtenPermissions()
+        << " 条权限，用时 " << seconds << " 秒" << Qt::endl;
+    return 0;
+}
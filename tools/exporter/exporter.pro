@@ -0,0 +1,13 @@
+# 导出工具：把用户权限矩阵流式导出为 CSV（SQLite / DM）
+QT       += core sql concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = learn1_export
+
+include(../../core.pri)
+
+SOURCES += \
+    main.cpp
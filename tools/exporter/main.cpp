@@ -0,0 +1,66 @@
+#include "../../config/configmanager.h"
+#include "../../database/databasemanager.h"
+#include "../../auth/permissionexporter.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+
+//用法：learn1_export [--output permissions.csv] [--config config.ini] [--progress-interval 100000]
+//导出全部用户及其功能权限（每个用户一行：userid,username,email,name,role_type，之后按功能目录顺序每个功能一列 function_<id>；
+//管理员的功能列全部为 1），
+//未指定 --output 或指定为 - 时写到标准输出，进度信息写到标准错误
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("导出用户权限矩阵（CSV）");
+    parser.addHelpOption();
+    QCommandLineOption configOption("config", "配置文件路径（默认按程序目录查找 config.ini）", "path");
+    QCommandLineOption outputOption("output", "输出文件，- 表示标准输出", "path", "-");
+    QCommandLineOption intervalOption("progress-interval", "每导出多少个用户报告一次进度", "users", "100000");
+    parser.addOptions({configOption, outputOption, intervalOption});
+    parser.process(app);
+
+    configmanager config;
+    if (parser.isSet(configOption) && !config.initConfigManager(parser.value(configOption))) {
+        err << "读取配置文件失败: " << parser.value(configOption) << Qt::endl;
+        return 1;
+    }
+    databasemanager dbManager(&config);
+    if (!dbManager.connectDatabase()) {
+        err << dbManager.getLastError() << Qt::endl;
+        return 1;
+    }
+
+    permissionexporter exporter(&dbManager);
+    exporter.setProgressInterval(parser.value(intervalOption).toInt());
+    exporter.setProgressCallback([&err](const exportprogress &progress) {
+        err << "已导出 " << progress.usersWritten << "/" << progress.usersTotal << " 个用户" << Qt::endl;
+    });
+
+    exportsummary summary;
+    const QString output = parser.value(outputOption);
+    if (output == "-") {
+        QFile stdoutFile;
+        if (!stdoutFile.open(stdout, QIODevice::WriteOnly)) {
+            err << "无法写入标准输出" << Qt::endl;
+            return 1;
+        }
+        summary = exporter.exportDevice(&stdoutFile);
+    } else {
+        summary = exporter.exportFile(output);
+    }
+
+    if (!summary.success) {
+        err << "导出失败: " << summary.error << Qt::endl;
+        return 1;
+    }
+    err << "完成：" << summary.progress.usersWritten << " 个用户，" << summary.progress.bytesWritten
+        << " 字节，用时 " << summary.elapsedMs / 1000.0 << " 秒" << Qt::endl;
+    return 0;
+}
@@ -0,0 +1,13 @@
+# 批量导入工具：从 CSV 导入用户与权限（SQLite / DM）
+QT       += core sql concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = learn1_import
+
+include(../../core.pri)
+
+SOURCES += \
+    main.cpp
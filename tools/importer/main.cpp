@@ -0,0 +1,107 @@
+#include "../../config/configmanager.h"
+#include "../../database/databasemanager.h"
+#include "../../auth/userimporter.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+
+//用法：learn1_import --file users.csv [--config config.ini] [--chunk 5000] [--errors errors.csv]
+//CSV 列为 username,email,name,password,permissions（首行可为表头，按列名匹配），
+//permissions 为以 ; 或 | 分隔的功能编号；数据库中已存在的用户名会被跳过
+//出错的行写入 --errors 指定的文件（行号,用户名,原因），否则打印到标准错误
+
+namespace {
+
+//CSV 字段转义
+QString csvField(const QString &text)
+{
+    if (text.contains(',') || text.contains('"') || text.contains('\n')) {
+        QString escaped = text;
+        escaped.replace("\"", "\"\"");
+        return "\"" + escaped + "\"";
+    }
+    return text;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("从 CSV 批量导入用户与权限");
+    parser.addHelpOption();
+    QCommandLineOption configOption("config", "配置文件路径（默认按程序目录查找 config.ini）", "path");
+    QCommandLineOption fileOption("file", "要导入的 CSV 文件", "path");
+    QCommandLineOption chunkOption("chunk", "每个事务写入的用户数", "rows", "5000");
+    QCommandLineOption errorsOption("errors", "出错行的输出文件（CSV）", "path");
+    QCommandLineOption maxErrorsOption("max-errors", "最多记录的出错行数", "count", "100000");
+    parser.addOptions({configOption, fileOption, chunkOption, errorsOption, maxErrorsOption});
+    parser.process(app);
+
+    if (!parser.isSet(fileOption)) {
+        err << "请用 --file 指定要导入的 CSV 文件" << Qt::endl;
+        return 2;
+    }
+
+    // 连接数据库并确保表结构存在
+    configmanager config;
+    if (parser.isSet(configOption) && !config.initConfigManager(parser.value(configOption))) {
+        err << "读取配置文件失败: " << parser.value(configOption) << Qt::endl;
+        return 1;
+    }
+    databasemanager dbManager(&config);
+    if (!dbManager.connectDatabase() || !dbManager.migrateSchema()) {
+        err << dbManager.getLastError() << Qt::endl;
+        return 1;
+    }
+
+    userimporter importer(&dbManager);
+    importer.setChunkSize(parser.value(chunkOption).toInt());
+    importer.setMaxErrors(parser.value(maxErrorsOption).toInt());
+    importer.setProgressCallback([&out](const importprogress &progress) {
+        out << "已读取 " << progress.rowsRead << " 行，导入 " << progress.imported
+            << "，跳过 " << progress.skipped << "，失败 " << progress.failed;
+        if (progress.bytesTotal > 0) {
+            out << "（" << progress.bytesRead * 100 / progress.bytesTotal << "%）";
+        }
+        out << Qt::endl;
+    });
+
+    const importsummary summary = importer.importFile(parser.value(fileOption));
+    if (!summary.error.isEmpty()) {
+        err << summary.error << Qt::endl;
+    }
+
+    // 输出出错的行
+    if (!summary.errors.isEmpty()) {
+        QFile errorsFile;
+        QTextStream errorsStream;
+        if (parser.isSet(errorsOption)) {
+            errorsFile.setFileName(parser.value(errorsOption));
+            if (!errorsFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+                err << "无法写入 " << errorsFile.fileName() << ": " << errorsFile.errorString() << Qt::endl;
+                return 1;
+            }
+            errorsStream.setDevice(&errorsFile);
+            errorsStream << "line,username,error\n";
+        } else {
+            errorsStream.setDevice(err.device());
+        }
+        for (const importerror &error : summary.errors) {
+            errorsStream << error.line << "," << csvField(error.username) << "," << csvField(error.message) << "\n";
+        }
+        errorsStream.flush();
+    }
+
+    const importprogress &progress = summary.progress;
+    const double seconds = summary.elapsedMs / 1000.0;
+    out << (summary.cancelled ? "已取消：" : "完成：") << "导入 " << progress.imported << " 个用户，跳过 "
+        << progress.skipped << "，失败 " << progress.failed << "，用时 " << seconds << " 秒" << Qt::endl;
+    return summary.success ? 0 : 1;
+}
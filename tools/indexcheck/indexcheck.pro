@@ -0,0 +1,13 @@
+# 索引自检工具：用 EXPLAIN 检查认证热点查询是否都走索引（SQLite / DM）
+QT       += core sql concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = learn1_indexcheck
+
+include(../../core.pri)
+
+SOURCES += \
+    main.cpp
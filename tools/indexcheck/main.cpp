@@ -0,0 +1,105 @@
+#include "../../config/configmanager.h"
+#include "../../database/databasemanager.h"
+#include "../../database/indexcatalog.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QTextStream>
+
+//用法：learn1_indexcheck [--config config.ini] [--no-migrate] [--verbose]
+//连接 config.ini 指定的数据库（默认先执行结构迁移以创建索引集合），对每条热点查询执行 EXPLAIN，
+//计划中出现全表扫描的查询判为失败；全部通过时返回 0，便于在部署后或 CI 中自检
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("检查认证热点查询的执行计划是否使用索引");
+    parser.addHelpOption();
+    QCommandLineOption configOption("config", "配置文件路径（默认按程序目录查找 config.ini）", "path");
+    QCommandLineOption noMigrateOption("no-migrate", "不执行结构迁移，只检查现有数据库");
+    QCommandLineOption verboseOption("verbose", "输出每条查询的完整执行计划");
+    parser.addOptions({configOption, noMigrateOption, verboseOption});
+    parser.process(app);
+
+    configmanager config;
+    if (parser.isSet(configOption) && !config.initConfigManager(parser.value(configOption))) {
+        err << "读取配置文件失败: " << parser.value(configOption) << Qt::endl;
+        return 1;
+    }
+    databasemanager dbManager(&config);
+    if (!dbManager.connectDatabase()) {
+        err << dbManager.getLastError() << Qt::endl;
+        return 1;
+    }
+    if (!parser.isSet(noMigrateOption) && !dbManager.migrateSchema()) {
+        err << dbManager.getLastError() << Qt::endl;
+        return 1;
+    }
+
+    connectionguard conn(dbManager.getConnectionPool());
+    if (!conn.isValid()) {
+        err << "获取数据库连接失败: " << dbManager.getConnectionPool()->getLastError() << Qt::endl;
+        return 1;
+    }
+
+    const sqldialect *dialect = dbManager.getDialect();
+    out << "数据库方言: " << dialect->name() << Qt::endl;
+
+    int failures = 0;
+    const QList<hotquery> queries = indexcatalog::hotQueries(dialect);
+    for (const hotquery &hot : queries) {
+        QSqlQuery query(conn.database());
+        query.setForwardOnly(true);
+        if (!query.prepare(dialect->explain(hot.sql))) {
+            out << "ERROR " << hot.name << ": " << query.lastError().text() << Qt::endl;
+            ++failures;
+            continue;
+        }
+        for (const QVariant &value : hot.bindValues) {
+            query.addBindValue(value);
+        }
+        if (!query.exec()) {
+            out << "ERROR " << hot.name << ": " << query.lastError().text() << Qt::endl;
+            ++failures;
+            continue;
+        }
+
+        // 不同数据库的计划列不同（SQLite 的 detail 为最后一列，DM 为整段文本），逐列逐行检查
+        QStringList plan;
+        QStringList fullScans;
+        while (query.next()) {
+            const int columns = query.record().count();
+            const QString text = query.value(columns - 1).toString();
+            const QStringList lines = text.split('\n', Qt::SkipEmptyParts);
+            for (const QString &line : lines) {
+                plan << line.trimmed();
+                if (dialect->isFullScan(line)) {
+                    fullScans << line.trimmed();
+                }
+            }
+        }
+        query.finish();
+
+        if (fullScans.isEmpty()) {
+            out << "OK    " << hot.name << Qt::endl;
+        } else {
+            out << "FAIL  " << hot.name << ": " << fullScans.join(" | ") << Qt::endl;
+            ++failures;
+        }
+        if (parser.isSet(verboseOption) || !fullScans.isEmpty()) {
+            for (const QString &line : plan) {
+                out << "        " << line << Qt::endl;
+            }
+        }
+    }
+
+    out << (failures == 0 ? "全部热点查询都使用了索引" : QString("%1 条查询未通过检查").arg(failures)) << Qt::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "latencystats.h"
+#include <QStringList>
+#include <algorithm>
+
+latencystats::latencystats()
+    : m_errors(0)
+    , m_totalNs(0)
+    , m_sorted(true)
+{
+}
+
+void latencystats::record(qint64 nsecs)
+{
+    m_samples.append(nsecs);
+    m_totalNs += nsecs;
+    m_sorted = false;
+}
+
+void latencystats::recordError()
+{
+    ++m_errors;
+}
+
+void latencystats::merge(const latencystats &other)
+{
+    m_samples += other.m_samples;
+    m_errors += other.m_errors;
+    m_totalNs += other.m_totalNs;
+    m_sorted = false;
+}
+
+qint64 latencystats::count() const
+{
+    return m_samples.size();
+}
+
+qint64 latencystats::errors() const
+{
+    return m_errors;
+}
+
+double latencystats::percentileMs(double p)
+{
+    if (m_samples.isEmpty()) {
+        return 0.0;
+    }
+    if (!m_sorted) {
+        std::sort(m_samples.begin(), m_samples.end());
+        m_sorted = true;
+    }
+    // 最近秩法
+    const int rank = qBound(0, static_cast<int>(p * m_samples.size() + 0.999999) - 1, m_samples.size() - 1);
+    return m_samples.at(rank) / 1e6;
+}
+
+double latencystats::meanMs() const
+{
+    return m_samples.isEmpty() ? 0.0 : m_totalNs / 1e6 / m_samples.size();
+}
+
+double latencystats::maxMs() const
+{
+    if (m_samples.isEmpty()) {
+        return 0.0;
+    }
+    return (m_sorted ? m_samples.last() : *std::max_element(m_samples.begin(), m_samples.end())) / 1e6;
+}
+
+QString latencystats::summary(const QString &name, double seconds)
+{
+    return QString("%1 count=%2 errors=%3 throughput=%4/s mean_ms=%5 p50_ms=%6 p95_ms=%7 p99_ms=%8 p999_ms=%9 max_ms=%10")
+        .arg(name)
+        .arg(count())
+        .arg(errors())
+        .arg(seconds > 0 ? count() / seconds : 0.0, 0, 'f', 1)
+        .arg(meanMs(), 0, 'f', 3)
+        .arg(percentileMs(0.50), 0, 'f', 3)
+        .arg(percentileMs(0.95), 0, 'f', 3)
+        .arg(percentileMs(0.99), 0, 'f', 3)
+        .arg(percentileMs(0.999), 0, 'f', 3)
+        .arg(maxMs(), 0, 'f', 3);
+}
+
+QString latencystats::histogram() const
+{
+    if (m_samples.isEmpty()) {
+        return QString();
+    }
+
+    // 区间 i 表示 [2^i, 2^(i+1)) 微秒，第 0 个区间包含 1 微秒以下
+    QVector<qint64> buckets(32, 0);
+    for (qint64 nsecs : m_samples) {
+        qint64 usecs = nsecs / 1000;
+        int bucket = 0;
+        while (usecs > 1 && bucket < buckets.size() - 1) {
+            usecs >>= 1;
+            ++bucket;
+        }
+        ++buckets[bucket];
+    }
+
+    int first = 0;
+    while (buckets.at(first) == 0) {
+        ++first;
+    }
+    int last = buckets.size() - 1;
+    while (buckets.at(last) == 0) {
+        --last;
+    }
+    const qint64 peak = *std::max_element(buckets.begin(), buckets.end());
+
+    QStringList lines;
+    for (int i = first; i <= last; ++i) {
+        const int width = peak > 0 ? static_cast<int>(40 * buckets.at(i) / peak) : 0;
+        lines << QString("  %1us - %2us %3 %4")
+                     .arg(i == 0 ? 0 : (qint64(1) << i), 10)
+                     .arg(qint64(1) << (i + 1), -10)
+                     .arg(buckets.at(i), 10)
+                     .arg(QString(width, QChar('#')));
+    }
+    return lines.join('\n');
+}
@@ -0,0 +1,39 @@
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+#include <QVector>
+#include <QString>
+
+//一类操作的延迟统计（样本单位纳秒）
+class latencystats
+{
+public:
+    latencystats();
+
+    void record(qint64 nsecs);
+    void recordError();
+
+    //合并其他线程的统计
+    void merge(const latencystats &other);
+
+    qint64 count() const;
+    qint64 errors() const;
+
+    //百分位延迟（毫秒），p 取 0~1；调用前会对样本排序
+    double percentileMs(double p);
+    double meanMs() const;
+    double maxMs() const;
+
+    //汇总行：name count=.. errors=.. throughput=../s p50_ms=.. p95_ms=.. p99_ms=.. p999_ms=.. max_ms=..
+    QString summary(const QString &name, double seconds);
+
+    //以 2 的幂为区间的延迟直方图（微秒），每行一个区间
+    QString histogram() const;
+
+private:
+    QVector<qint64> m_samples;
+    qint64 m_errors;
+    qint64 m_totalNs;
+    bool m_sorted;
+};
+
+#endif // LATENCYSTATS_H
@@ -0,0 +1,17 @@
+# 并发登录负载测试：多线程重放登录 / 权限查询，输出吞吐量与延迟分位数
+QT       += core sql concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = learn1_loaddriver
+
+include(../../core.pri)
+
+SOURCES += \
+    main.cpp \
+    latencystats.cpp
+
+HEADERS += \
+    latencystats.h
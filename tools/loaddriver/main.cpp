@@ -0,0 +1,256 @@
+#include "latencystats.h"
+#include "../../config/configmanager.h"
+#include "../../database/databasemanager.h"
+#include "../../database/userbulkwriter.h"
+#include "../../auth/authmanager.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QSettings>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QSqlQuery>
+#include <atomic>
+
+//用法：learn1_loaddriver [--threads 64] [--duration 10] [--mix 70] [--bad-password 5]
+//                        [--users 10000] [--prefix gen] [--password Passw0rd] [--config config.ini]
+//不指定 --config 时在临时目录中建立 SQLite 数据库并写入 --users 个用户，无需任何外部服务；
+//指定 --config 时使用其中的数据库，用户需已由 learn1_datagen 以相同的 --prefix / --password 生成
+//每个工作线程从连接池借用属于自己的连接，按比例重放登录与权限查询
+
+namespace {
+
+//单个工作线程的统计
+struct workerstats
+{
+    latencystats login;
+    latencystats permissions;
+};
+
+struct loadoptions
+{
+    int threads = 64;
+    int durationSec = 10;
+    int warmupSec = 1;
+    int loginPercent = 70;       // 其余为权限查询
+    int badPasswordPercent = 5;  // 登录请求中使用错误密码的比例
+    int users = 10000;
+    QString prefix;
+    QString password;
+};
+
+QString usernameOf(const QString &prefix, int index)
+{
+    return QString("%1%2").arg(prefix).arg(index, 7, 10, QChar('0'));
+}
+
+//在临时 SQLite 数据库中写入测试用户
+bool seedLocalDatabase(databasemanager *dbManager, const loadoptions &options, QString *error)
+{
+    const functioncatalog catalog = dbManager->getFunctionCatalog();
+    connectionguard conn(dbManager->getConnectionPool());
+    if (!conn.isValid()) {
+        *error = dbManager->getConnectionPool()->getLastError();
+        return false;
+    }
+    userbulkwriter writer(conn.database());
+    writer.setChunkSize(50000);
+    const QString passwordHash = AuthManager::hashPassword(options.password);
+    QRandomGenerator random(1);
+    for (int i = 1; i <= options.users; ++i) {
+        bulkuser user;
+        user.username = usernameOf(options.prefix, i);
+        user.passwordHash = passwordHash;
+        user.email = user.username + "@example.com";
+        user.name = user.username;
+        for (const functioninfo &function : catalog.functions()) {
+            if (random.bounded(2) == 1) {
+                user.enabledFunctions.append(function.id);
+            }
+        }
+        if (!writer.append(user)) {
+            *error = writer.getLastError();
+            return false;
+        }
+    }
+    if (!writer.flush()) {
+        *error = writer.getLastError();
+        return false;
+    }
+    return true;
+}
+
+//工作线程：到达截止时间前循环发送请求；预热期内的请求不计入统计
+workerstats runWorker(const AuthManager *authManager, const loadoptions &options, int workerIndex,
+                      const std::atomic<bool> *started, qint64 measureFromMs, qint64 stopAtMs,
+                      const QElapsedTimer *clock)
+{
+    workerstats stats;
+    QRandomGenerator random(static_cast<quint32>(1000 + workerIndex));
+    while (!started->load()) {
+        QThread::yieldCurrentThread();
+    }
+
+    QElapsedTimer timer;
+    for (;;) {
+        const qint64 now = clock->elapsed();
+        if (now >= stopAtMs) {
+            break;
+        }
+        const bool measured = now >= measureFromMs;
+        const QString username = usernameOf(options.prefix, 1 + random.bounded(options.users));
+
+        if (static_cast<int>(random.bounded(100)) < options.loginPercent) {
+            const bool badPassword = static_cast<int>(random.bounded(100)) < options.badPasswordPercent;
+            timer.start();
+            const loginresult result = authManager->tryLogin(username, badPassword ? QString("wrong-password") : options.password);
+            const qint64 elapsed = timer.nsecsElapsed();
+            if (!measured) {
+                continue;
+            }
+            // 错误密码被拒绝属于预期结果
+            if (result.success != badPassword) {
+                stats.login.record(elapsed);
+            } else {
+                stats.login.recordError();
+            }
+        } else {
+            timer.start();
+            authManager->getUserFunctionPermissions(username);
+            const qint64 elapsed = timer.nsecsElapsed();
+            if (measured) {
+                stats.permissions.record(elapsed);
+            }
+        }
+    }
+    return stats;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("并发登录负载测试");
+    parser.addHelpOption();
+    QCommandLineOption configOption("config", "使用指定配置文件中的数据库（默认使用临时 SQLite 数据库）", "path");
+    QCommandLineOption threadsOption("threads", "并发工作线程数", "count", "64");
+    QCommandLineOption durationOption("duration", "统计时长（秒）", "seconds", "10");
+    QCommandLineOption warmupOption("warmup", "预热时长（秒），不计入统计", "seconds", "1");
+    QCommandLineOption mixOption("mix", "登录请求所占百分比，其余为权限查询", "percent", "70");
+    QCommandLineOption badPasswordOption("bad-password", "登录请求中使用错误密码的百分比", "percent", "5");
+    QCommandLineOption usersOption("users", "用户数（临时数据库写入的用户数，或已有数据中可用的用户数）", "count", "10000");
+    QCommandLineOption prefixOption("prefix", "用户名前缀（与 learn1_datagen 一致）", "text", "gen");
+    QCommandLineOption passwordOption("password", "用户的明文密码（与 learn1_datagen 一致）", "text", "Passw0rd");
+    parser.addOptions({configOption, threadsOption, durationOption, warmupOption, mixOption,
+                       badPasswordOption, usersOption, prefixOption, passwordOption});
+    parser.process(app);
+
+    loadoptions options;
+    options.threads = qMax(1, parser.value(threadsOption).toInt());
+    options.durationSec = qMax(1, parser.value(durationOption).toInt());
+    options.warmupSec = qMax(0, parser.value(warmupOption).toInt());
+    options.loginPercent = qBound(0, parser.value(mixOption).toInt(), 100);
+    options.badPasswordPercent = qBound(0, parser.value(badPasswordOption).toInt(), 100);
+    options.users = qMax(1, parser.value(usersOption).toInt());
+    options.prefix = parser.value(prefixOption);
+    options.password = parser.value(passwordOption);
+
+    // 准备数据库配置：默认在临时目录中建立 SQLite 数据库，连接池容量与线程数一致
+    QTemporaryDir tempDir;
+    const bool local = !parser.isSet(configOption);
+    QString iniPath = parser.value(configOption);
+    if (local) {
+        if (!tempDir.isValid()) {
+            err << "无法创建临时目录" << Qt::endl;
+            return 1;
+        }
+        iniPath = tempDir.path() + "/config.ini";
+        QSettings settings(iniPath, QSettings::IniFormat);
+        settings.beginGroup("Database");
+        settings.setValue("Type", "SQLITE");
+        settings.setValue("DatabaseName", tempDir.path() + "/learn1_load.db");
+        settings.setValue("PoolMinSize", 1);
+        settings.setValue("PoolMaxSize", options.threads + 1);
+        settings.setValue("PoolBorrowTimeout", 30000);
+        settings.endGroup();
+        settings.sync();
+    }
+
+    configmanager config;
+    if (!config.initConfigManager(iniPath)) {
+        err << "读取配置文件失败: " << iniPath << Qt::endl;
+        return 1;
+    }
+    const int poolMax = config.getPoolConfig().value("PoolMaxSize", "8").toInt();
+    if (poolMax < options.threads) {
+        err << "警告：连接池最大连接数 " << poolMax << " 小于线程数 " << options.threads
+            << "，部分线程会等待连接" << Qt::endl;
+    }
+
+    databasemanager dbManager(&config);
+    if (!dbManager.connectDatabase() || !dbManager.migrateSchema()) {
+        err << dbManager.getLastError() << Qt::endl;
+        return 1;
+    }
+    if (local) {
+        QElapsedTimer seedTimer;
+        seedTimer.start();
+        QString error;
+        if (!seedLocalDatabase(&dbManager, options, &error)) {
+            err << "写入测试用户失败: " << error << Qt::endl;
+            return 1;
+        }
+        out << "已写入 " << options.users << " 个测试用户，用时 " << seedTimer.elapsed() << " 毫秒" << Qt::endl;
+    }
+
+    AuthManager authManager(&dbManager);
+
+    // 每个任务独占一个线程，线程在压测期间常驻，因此各自复用连接池中属于自己的连接
+    QThreadPool workers;
+    workers.setMaxThreadCount(options.threads);
+    workers.setExpiryTimeout(-1);
+
+    std::atomic<bool> started(false);
+    QElapsedTimer clock;
+    const qint64 measureFromMs = options.warmupSec * 1000;
+    const qint64 stopAtMs = measureFromMs + options.durationSec * 1000;
+    QList<QFuture<workerstats>> futures;
+    for (int i = 0; i < options.threads; ++i) {
+        futures.append(QtConcurrent::run(&workers, [&, i]() {
+            return runWorker(&authManager, options, i, &started, measureFromMs, stopAtMs, &clock);
+        }));
+    }
+    out << "开始压测：" << options.threads << " 个线程，预热 " << options.warmupSec << " 秒，统计 "
+        << options.durationSec << " 秒，登录占比 " << options.loginPercent << "%" << Qt::endl;
+    clock.start();
+    started = true;
+
+    workerstats total;
+    for (QFuture<workerstats> &future : futures) {
+        const workerstats stats = future.result();
+        total.login.merge(stats.login);
+        total.permissions.merge(stats.permissions);
+    }
+    workers.waitForDone();
+
+    latencystats overall;
+    overall.merge(total.login);
+    overall.merge(total.permissions);
+
+    const double seconds = options.durationSec;
+    out << total.login.summary("login", seconds) << Qt::endl;
+    out << total.permissions.summary("permissions", seconds) << Qt::endl;
+    out << overall.summary("all", seconds) << Qt::endl;
+    out << "latency histogram (all):" << Qt::endl << overall.histogram() << Qt::endl;
+    return overall.errors() > 0 ? 3 : 0;
+}
@@ -0,0 +1,114 @@
+#include "apptheme.h"
+
+#include <QApplication>
+
+const char *const AppTheme::LOGIN_PAGE = "loginPage";
+const char *const AppTheme::REGISTER_PAGE = "registerPage";
+const char *const AppTheme::MAIN_PAGE = "mainPage";
+
+QString AppTheme::styleSheet()
+{
+    return QString(
+        "#loginPage #centerPanel, #registerPage #centerPanel, #mainPage #centerPanel { background: transparent; }"
+        "#mainPage #functionScrollArea, #mainPage #functionScrollArea > #qt_scrollarea_viewport, #mainPage #functionArea {"
+            "background: transparent;"
+            "border: none;"
+        "}"
+
+        /* 登录、注册页：仅给字段标签添加纯蓝圆角背景与白字 */
+        "#loginPage #fieldLabel, #registerPage #fieldLabel {"
+            "background:#6CA6CD;"
+            "color:#ffffff;"
+            "border-radius:10px;"
+            "padding:2px 8px;"
+        "}"
+
+        /* 输入框：圆角、浅边框、聚焦高亮 */
+        "#loginPage QLineEdit, #registerPage QLineEdit {"
+            "padding:6px 10px;"
+            "border:1px solid #6CA6CD;"
+            "border-radius:10px;"
+            "background:#ffffff;"
+        "}"
+        "#loginPage QLineEdit:focus, #registerPage QLineEdit:focus {"
+            "border-color:#6CA6CD;"
+            "background:#ffffff;"
+        "}"
+
+        /* 按钮：统一蓝底白字、圆角、hover/pressed 态 */
+        "#loginPage #loginButton, #loginPage #registerButton, #registerPage #backButton, #registerPage #registerButton {"
+            "padding:0 14px;"
+            "border-radius:10px;"
+            "border:1px solid #6CA6CD;"
+            "background:#6CA6CD;"
+            "color:#ffffff;"
+        "}"
+        "#loginPage #loginButton:hover, #loginPage #registerButton:hover, #registerPage #backButton:hover, #registerPage #registerButton:hover { background:#6CA6CD; }"
+        "#loginPage #loginButton:pressed, #loginPage #registerButton:pressed, #registerPage #backButton:pressed, #registerPage #registerButton:pressed { background:#6CA6CD; }"
+        "#loginPage #loginButton:disabled, #loginPage #registerButton:disabled { background:#A9C8DC; border-color:#A9C8DC; }"
+
+        /* 登录页：数据库连接状态文字 */
+        "#loginPage #statusLabel { color:#ffffff; background:#6CA6CD; border-radius:6px; padding:2px 8px; }"
+
+        /* 主内容页：功能按钮 */
+        "#mainPage QPushButton[objectName^=\"functionButton\"] {"
+            "padding: 0 20px;"
+            "border-radius: 10px;"
+            "border: none;"
+            "background: #6CA6CD;"
+            "color: #ffffff;"
+        "}"
+        "#mainPage QPushButton[objectName^=\"functionButton\"]:hover {"
+            "background: #5B9BD5;"
+        "}"
+        "#mainPage QPushButton[objectName^=\"functionButton\"]:pressed {"
+            "background: #4A8BC4;"
+        "}"
+        "#mainPage QPushButton[objectName^=\"functionButton\"]:focus {"
+            "outline: none;"
+            "border: none;"
+        "}"
+        /* 禁用状态的按钮样式（灰色） */
+        "#mainPage QPushButton[objectName^=\"functionButton\"]:disabled {"
+            "background: #CCCCCC;"
+            "color: #888888;"
+        "}"
+        /* 权限管理、批量导入按钮 */
+        "#mainPage #permissionButton, #mainPage #importButton {"
+            "padding: 8px 16px;"
+            "border-radius: 5px;"
+            "border: none;"
+            "background: #8B7355;"
+            "color: #ffffff;"
+            "font-size: 12px;"
+        "}"
+        "#mainPage #permissionButton:hover, #mainPage #importButton:hover {"
+            "background: #7A6344;"
+        "}"
+        "#mainPage #permissionButton:pressed, #mainPage #importButton:pressed {"
+            "background: #6A5334;"
+        "}"
+        /* 退出登录按钮 */
+        "#mainPage #logoutButton {"
+            "padding: 8px 16px;"
+            "border-radius: 5px;"
+            "border: none;"
+            "background: #DC143C;"
+            "color: #ffffff;"
+            "font-size: 12px;"
+        "}"
+        "#mainPage #logoutButton:hover {"
+            "background: #B22222;"
+        "}"
+        "#mainPage #logoutButton:pressed {"
+            "background: #8B0000;"
+        "}"
+    );
+}
+
+void AppTheme::apply(QApplication *app)
+{
+    if (app) {
+        app->setStyleSheet(styleSheet());
+    }
+}
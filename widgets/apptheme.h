@@ -0,0 +1,25 @@
+#ifndef APPTHEME_H
+#define APPTHEME_H
+
+#include <QString>
+
+class QApplication;
+
+// 界面主题：所有页面的样式集中在一份应用级样式表中，启动时设置一次，
+// 各页面通过对象名（#loginPage 等）限定选择器，不再各自调用 setStyleSheet
+class AppTheme
+{
+public:
+    // 页面对象名（样式表选择器使用）
+    static const char *const LOGIN_PAGE;
+    static const char *const REGISTER_PAGE;
+    static const char *const MAIN_PAGE;
+
+    // 完整的应用级样式表
+    static QString styleSheet();
+
+    // 设置到应用程序（在创建任何页面之前调用一次）
+    static void apply(QApplication *app);
+};
+
+#endif // APPTHEME_H
@@ -0,0 +1,147 @@
+#include "backgroundimagecache.h"
+
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QImageReader>
+#include <QPainter>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+#include <QtConcurrent>
+
+namespace {
+// 成品缓存上限（KB）：足够保存几种常用窗口尺寸，拖动缩放产生的中间尺寸会被淘汰
+// 超过上限的成品（高 DPI 大窗口）不进入缓存，只保存在 m_current 中
+const int SCALED_CACHE_KB = 32 * 1024;
+
+// 解码图片；原图大于 bound 时解码阶段直接缩小，之后每次缩放的代价更低
+QImage decodeImage(const QString &path, const QSize &bound)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+    const QSize original = reader.size();
+    if (original.isValid() && bound.isValid()
+        && (original.width() > bound.width() || original.height() > bound.height())) {
+        reader.setScaledSize(original.scaled(bound, Qt::KeepAspectRatioByExpanding));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qDebug() << "背景图解码失败:" << path << reader.errorString();
+        return image;
+    }
+    return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                         : QImage::Format_RGB32);
+}
+}
+
+BackgroundImageCache::BackgroundImageCache(QObject *parent)
+    : QObject(parent)
+    , m_pathResolved(false)
+{
+    m_scaled.setMaxCost(SCALED_CACHE_KB);
+    connect(&m_loader, &QFutureWatcher<QImage>::finished, this, [this]() {
+        m_source = m_loader.result();
+        m_currentKey.clear();
+        m_current = QPixmap();
+        m_scaled.clear();
+        if (!m_source.isNull()) {
+            emit imageReady();
+        }
+    });
+    startLoading();
+}
+
+BackgroundImageCache *BackgroundImageCache::instance()
+{
+    // 以 QApplication 为父对象，随应用程序一起销毁
+    static BackgroundImageCache *cache = new BackgroundImageCache(QCoreApplication::instance());
+    return cache;
+}
+
+QString BackgroundImageCache::imagePath()
+{
+    if (m_pathResolved) {
+        return m_path;
+    }
+    m_pathResolved = true;
+
+    QString curDir = QCoreApplication::applicationDirPath();
+    for (int level = 0; level < 6; ++level) {
+        const QString base = curDir + "/resources/";
+        const QString jpg = base + "loginWidget.jpg";
+        const QString png = base + "loginWidget.png";
+        if (QFile::exists(jpg)) {
+            m_path = jpg;
+            break;
+        }
+        if (QFile::exists(png)) {
+            m_path = png;
+            break;
+        }
+        // 上移一层
+        curDir = QDir::cleanPath(curDir + "/..");
+    }
+    return m_path;
+}
+
+bool BackgroundImageCache::isReady() const
+{
+    return !m_source.isNull();
+}
+
+void BackgroundImageCache::startLoading()
+{
+    const QString path = imagePath();
+    if (path.isEmpty()) {
+        qDebug() << "未找到背景图 resources/loginWidget.jpg";
+        return;
+    }
+
+    // 解码尺寸上限取最大屏幕的物理像素尺寸
+    QSize bound;
+    const QList<QScreen *> screens = QGuiApplication::screens();
+    for (QScreen *screen : screens) {
+        bound = bound.expandedTo(screen->size() * screen->devicePixelRatio());
+    }
+
+    m_loader.setFuture(QtConcurrent::run([path, bound]() {
+        return decodeImage(path, bound);
+    }));
+}
+
+QPixmap BackgroundImageCache::pixmap(const QSize &size, qreal devicePixelRatio, const QColor &base)
+{
+    if (m_source.isNull() || size.isEmpty()) {
+        return QPixmap();
+    }
+
+    const QString key = QString("%1x%2@%3#%4").arg(size.width()).arg(size.height())
+                            .arg(devicePixelRatio).arg(base.rgba());
+    if (key == m_currentKey) {
+        return m_current;
+    }
+    if (QPixmap *cached = m_scaled.object(key)) {
+        m_currentKey = key;
+        m_current = *cached;
+        return m_current;
+    }
+
+    // 生成成品：先铺底色，再按固定不透明度叠加缩放后的图片，绘制时无需再缩放与混合
+    QPixmap *composed = new QPixmap(size * devicePixelRatio);
+    composed->setDevicePixelRatio(devicePixelRatio);
+    composed->fill(base);
+    {
+        QPainter painter(composed);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        painter.setOpacity(BACKGROUND_OPACITY);
+        painter.drawImage(QRect(QPoint(0, 0), size), m_source);
+    }
+
+    m_currentKey = key;
+    m_current = *composed;
+    const int costKb = qMax(1, composed->width() * composed->height() * 4 / 1024);
+    m_scaled.insert(key, composed, costKb);
+    return m_current;
+}
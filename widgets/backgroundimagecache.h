@@ -0,0 +1,55 @@
+#ifndef BACKGROUNDIMAGECACHE_H
+#define BACKGROUNDIMAGECACHE_H
+
+#include <QObject>
+#include <QImage>
+#include <QPixmap>
+#include <QColor>
+#include <QSize>
+#include <QCache>
+#include <QString>
+#include <QFutureWatcher>
+
+// 页面背景图服务：登录、注册、主界面共用
+// 图片只查找与解码一次（在后台线程），并按控件尺寸缓存已缩放、已叠加透明度的成品，
+// 绘制时直接贴图，只有尺寸变化时才重新生成
+class BackgroundImageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 背景图叠加在窗口底色上的不透明度
+    static constexpr qreal BACKGROUND_OPACITY = 0.6;
+
+    static BackgroundImageCache *instance();
+
+    // 背景图文件路径（从程序目录向上查找 resources/loginWidget.jpg|png，结果只查找一次）
+    QString imagePath();
+
+    // 图片是否已解码完成
+    bool isReady() const;
+
+    // 获取指定尺寸的背景成品（底色 + 缩放后的图片），图片尚未解码完成时返回空图
+    QPixmap pixmap(const QSize &size, qreal devicePixelRatio, const QColor &base);
+
+signals:
+    // 后台解码完成，使用背景图的页面需要重绘
+    void imageReady();
+
+private:
+    explicit BackgroundImageCache(QObject *parent = nullptr);
+    Q_DISABLE_COPY(BackgroundImageCache)
+
+    // 在后台线程中解码图片
+    void startLoading();
+
+    QString m_path;
+    bool m_pathResolved;
+    QImage m_source;                        // 解码后的原图（超过屏幕尺寸时已预先缩小）
+    QString m_currentKey;                   // 最近一次使用的尺寸
+    QPixmap m_current;                      // 最近一次使用的成品，不受缓存上限影响
+    QCache<QString, QPixmap> m_scaled;      // 尺寸 -> 成品，开销按 KB 计
+    QFutureWatcher<QImage> m_loader;
+};
+
+#endif // BACKGROUNDIMAGECACHE_H
@@ -1,4 +1,7 @@
 #include "loginwidget.h"
+#include "backgroundimagecache.h"
+#include "apptheme.h"
+#include "../metrics/rendermetrics.h"
 #include "../auth/authmanager.h"
 
 #include <QLabel>
@@ -12,17 +15,19 @@
 #include <QPainter>
 #include <QPaintEvent>
 #include <QPixmap>
-#include <QFileInfo>
-#include <QFile>
-#include <QCoreApplication>
 #include <QDebug>
-#include <QDir>
 #include <QMessageBox>
+#include <QProgressBar>
+#include <QFutureWatcher>
 
 LoginWidget::LoginWidget(QWidget *parent) 
     : QWidget(parent)
+    , m_backendReady(false)
     , m_authManager(nullptr)
+    , m_requestSerial(0)
 {
+	// 样式由应用级样式表（AppTheme）按页面对象名提供
+	setObjectName(AppTheme::LOGIN_PAGE);
 	setupUI();
 	applyStyles();
 
@@ -46,6 +51,31 @@ void LoginWidget::clearInputFields()
     m_passwordEdit->clear();
 }
 
+void LoginWidget::cancelPendingRequests()
+{
+    // 递增序号后，已发出请求的结果返回时会被直接丢弃
+    ++m_requestSerial;
+    setBusy(false);
+}
+
+void LoginWidget::setBackendReady(bool ready, const QString &status)
+{
+    m_backendReady = ready;
+    // 窗口尚未显示时 isVisible() 总是 false，这里按指示条自身是否被隐藏判断
+    m_loginButton->setEnabled(ready && m_busyIndicator->isHidden());
+    m_statusLabel->setText(status);
+    m_statusLabel->setVisible(!status.isEmpty());
+}
+
+void LoginWidget::setBusy(bool busy)
+{
+    m_busyIndicator->setVisible(busy);
+    m_loginButton->setEnabled(!busy && m_backendReady);
+    m_registerButton->setEnabled(!busy);
+    m_usernameEdit->setEnabled(!busy);
+    m_passwordEdit->setEnabled(!busy);
+}
+
 void LoginWidget::setupUI()
 {
 	// 创建控件
@@ -73,6 +103,21 @@ void LoginWidget::setupUI()
 	m_usernameLabel->setObjectName("fieldLabel");
 	m_passwordLabel->setObjectName("fieldLabel");
 
+	// 忙碌指示（不确定进度的进度条），登录请求进行中显示
+	m_busyIndicator = new QProgressBar(this);
+	m_busyIndicator->setRange(0, 0);
+	m_busyIndicator->setTextVisible(false);
+	m_busyIndicator->setMaximumHeight(6);
+	m_busyIndicator->hide();
+
+	// 数据库连接状态（连接完成前显示“正在连接数据库…”）
+	m_statusLabel = new QLabel(this);
+	m_statusLabel->setObjectName("statusLabel");
+	m_statusLabel->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
+	m_statusLabel->setWordWrap(true);
+	m_statusLabel->hide();
+	m_loginButton->setEnabled(false);
+
 	// 表单布局（两行：用户名、密码）
 	QFormLayout *formLayout = new QFormLayout();
 	// 控制表单内左右控件之间的水平间距（标签 与 输入框）
@@ -101,6 +146,8 @@ void LoginWidget::setupUI()
 	QVBoxLayout *formAndButtons = new QVBoxLayout();
 	formAndButtons->addLayout(formLayout);
 	formAndButtons->addLayout(buttonsRow);
+	formAndButtons->addWidget(m_busyIndicator);
+	formAndButtons->addWidget(m_statusLabel);
 	// 避免默认 spacing 与 addSpacing 叠加导致距离偏大
 	// 控制“表单区域 与 按钮区域”之间的垂直间距
 	formAndButtons->setSpacing(18); 
@@ -182,93 +229,26 @@ void LoginWidget::applyStyles()
 		layout()->setContentsMargins(24, 24, 24, 24);
 		layout()->setSpacing(12);
 	}
-
-	// 现代化外观样式（可迁移到外部 QSS）
-	this->setStyleSheet(
-		"#centerPanel { background: transparent; }"
-
-		/* 仅给用户名/密码标签添加纯蓝圆角背景与白字 */
-		"#fieldLabel {"
-            "background:#6CA6CD;"
-			"color:#ffffff;"
-			"border-radius:10px;"
-			"padding:2px 8px;"
-		"}"
-
-		/* 输入框：圆角、浅边框、聚焦高亮与阴影 */
-		"QLineEdit {"
-			"padding:6px 10px;"
-            "border:1px solid #6CA6CD;"
-			"border-radius:10px;"
-			"background:#ffffff;"
-		"}"
-		"QLineEdit:focus {"
-            "border-color:#6CA6CD;"
-			"background:#ffffff;"
-		"}"
-
-		/* 按钮：统一白色、圆角、浅边框、hover/pressed 态 */
-		"#loginButton, #registerButton {"
-			"padding:0 14px;"
-			"border-radius:10px;"
-            "border:1px solid #6CA6CD;"
-            "background:#6CA6CD;"
-			"color:#ffffff;"
-		"}"
-        "#loginButton:hover, #registerButton:hover { background:#6CA6CD; }" /* LightSkyBlue hover 同色系稍亮 */
-        "#loginButton:pressed, #registerButton:pressed { background:#6CA6CD; }"
-	);
 }
 
 void LoginWidget::setBackgroundImage()
 {
-	QString startDir = QCoreApplication::applicationDirPath();
-
-	QString path;
-	QString curDir = startDir;
-	for (int level = 0; level < 6 && path.isEmpty(); ++level) {
-		const QString base = curDir + "/resources/";
-		const QString jpg = base + "loginWidget.jpg";
-		const QString png = base + "loginWidget.png";
-		const bool jpgExists = QFile::exists(jpg);
-		const bool pngExists = QFile::exists(png);
-		if (jpgExists) {
-			path = jpg;
-			break;
-		}
-		if (pngExists) {
-			path = png;
-			break;
-		}
-		// 上移一层
-		curDir = QDir::cleanPath(curDir + "/..");
-	}
-
-	// 使用样式表 border-image 自适应填充，随窗口变化自动缩放
-	if (!path.isEmpty()) {
-		QPixmap probe(path); 
-		if (!probe.isNull()) {
-			m_bgPixmap = probe;
-			update(); // 触发重绘
-		}
-
-		// 叠加样式，避免覆盖先前的控件样式
-		const QString prev = this->styleSheet();
-		this->setStyleSheet(prev + "\n" + QString(
-			"border-image: url(%1) 0 0 0 0 stretch stretch;"
-		).arg(path));
-	} else {
-	}
+	// 背景图只在 paintEvent 中绘制一次（不再叠加 border-image 样式，避免重复绘制与整页样式重算）
+	// 图片由共享的 BackgroundImageCache 在后台解码并按尺寸缓存，解码完成后重绘
+	connect(BackgroundImageCache::instance(), &BackgroundImageCache::imageReady, this, [this]() {
+		update();
+	});
 }
 
 void LoginWidget::paintEvent(QPaintEvent *event)
 {
-    if (!m_bgPixmap.isNull()) {
+    painttimer timer("login");
+    // 直接贴上当前尺寸的成品（已缩放并叠加透明度），尺寸不变时不再缩放
+    const QPixmap background = BackgroundImageCache::instance()->pixmap(
+        size(), devicePixelRatioF(), palette().color(QPalette::Window));
+    if (!background.isNull()) {
         QPainter p(this);
-        p.setRenderHint(QPainter::SmoothPixmapTransform, true);
-        const qreal opacity = 0.6;
-		p.setOpacity(opacity);
-        p.drawPixmap(rect(), m_bgPixmap);
+        p.drawPixmap(0, 0, background);
     }
     QWidget::paintEvent(event);
 }
@@ -324,16 +304,29 @@ void LoginWidget::onLoginButtonClicked()
 		return;
 	}
 	
-	// 4. 调用认证管理器验证登录
-	if (m_authManager->login(username, password)) {
-		// 登录成功
-		emit loginSuccess(username);
-	} else {
-		// 登录失败，获取错误信息
-		QString errorMsg = m_authManager->getLastError();
-		QMessageBox::warning(this, "登录失败", errorMsg);
-		emit loginFailed(errorMsg);
-	}
+	// 4. 在数据库线程中异步验证登录，界面线程不等待
+	setBusy(true);
+	const quint64 serial = ++m_requestSerial;
+	QFutureWatcher<loginresult> *watcher = new QFutureWatcher<loginresult>(this);
+	connect(watcher, &QFutureWatcher<loginresult>::finished, this, [this, watcher, serial]() {
+		watcher->deleteLater();
+		// 请求已被取消
+		if (serial != m_requestSerial) {
+			return;
+		}
+		setBusy(false);
+
+		const loginresult result = watcher->result();
+		if (result.success) {
+			// 登录成功，会话中已包含身份、角色与权限
+			emit loginSuccess(result.session);
+		} else {
+			// 登录失败，显示错误信息
+			QMessageBox::warning(this, "登录失败", result.error);
+			emit loginFailed(result.error);
+		}
+	});
+	watcher->setFuture(m_authManager->loginAsync(username, password));
 }
 
 
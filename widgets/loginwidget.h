@@ -2,6 +2,7 @@
 #define LOGINWIDGET_H
 #include <QWidget>
 #include <QPixmap>
+#include "../auth/usersession.h"
 
 class AuthManager;
 
@@ -12,11 +13,14 @@ public:
     LoginWidget(QWidget *parent = nullptr);
     void setAuthManager(AuthManager *authManager);
     void clearInputFields();  // 清空所有输入框
+    void cancelPendingRequests();  // 取消尚未返回的登录请求
+    //后台数据库是否就绪：未就绪时禁用登录按钮并显示状态文字
+    void setBackendReady(bool ready, const QString &status = QString());
 
 	void setBackgroundImage();
 
 signals:
-    void loginSuccess(const QString &username);
+    void loginSuccess(const usersession &session);
     void loginFailed(const QString &errorMessage);
     void changeToRegister();
 
@@ -29,6 +33,9 @@ private:
     //验证输入格式是否正确
     bool validateInput();
 
+    //请求进行中：显示忙碌指示并禁用按钮
+    void setBusy(bool busy);
+
 
 private slots:
     //登录按钮点击槽函数
@@ -44,8 +51,11 @@ private:
 	class QPushButton *m_loginButton;
 	class QPushButton *m_registerButton;
 	class QWidget *m_centerPanel;
-	QPixmap m_bgPixmap;
+	class QProgressBar *m_busyIndicator;  // 登录请求进行中的忙碌指示
+	class QLabel *m_statusLabel;          // 数据库连接状态
+	bool m_backendReady;                  // 数据库是否已连接并完成结构迁移
 	AuthManager *m_authManager;  // 认证管理器
+	quint64 m_requestSerial;     // 请求序号，用于丢弃已取消请求的结果
 };
 
 #endif // LOGINWIDGET_H
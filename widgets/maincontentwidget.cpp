@@ -1,30 +1,33 @@
 #include "maincontentwidget.h"
+#include "backgroundimagecache.h"
+#include "apptheme.h"
+#include "../metrics/rendermetrics.h"
 #include "../auth/authmanager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include <QGridLayout>
+#include <QScrollArea>
 #include <QPushButton>
 #include <QPainter>
 #include <QPaintEvent>
 #include <QPixmap>
-#include <QFileInfo>
-#include <QFile>
-#include <QCoreApplication>
-#include <QDir>
 #include <QFont>
 #include <QDebug>
 #include <QMessageBox>
+#include <QFutureWatcher>
 
 MainContentWidget::MainContentWidget(QWidget *parent)
     : QWidget(parent)
     , m_authManager(nullptr)
-    , m_functionButton1(nullptr)
-    , m_functionButton2(nullptr)
-    , m_functionButton3(nullptr)
-    , m_functionButton4(nullptr)
-    , m_functionButton5(nullptr)
+    , m_centerPanel(nullptr)
+    , m_buttonsLayout(nullptr)
     , m_permissionButton(nullptr)
+    , m_importButton(nullptr)
     , m_logoutButton(nullptr)
+    , m_requestSerial(0)
 {
+    // 样式由应用级样式表（AppTheme）按页面对象名提供
+    setObjectName(AppTheme::MAIN_PAGE);
     setupUI();
     applyStyles();
     setBackgroundImage();
@@ -32,69 +35,67 @@ MainContentWidget::MainContentWidget(QWidget *parent)
 
 void MainContentWidget::setupUI()
 {
-    // 创建5个功能按钮
-    m_functionButton1 = new QPushButton("功能一", this);
-    m_functionButton2 = new QPushButton("功能二", this);
-    m_functionButton3 = new QPushButton("功能三", this);
-    m_functionButton4 = new QPushButton("功能四", this);
-    m_functionButton5 = new QPushButton("功能五", this);
-    
     // 创建权限管理按钮（初始隐藏，仅管理员可见）
     m_permissionButton = new QPushButton("权限管理", this);
     m_permissionButton->setObjectName("permissionButton");
     m_permissionButton->hide();
     connect(m_permissionButton, &QPushButton::clicked, this, &MainContentWidget::onPermissionManagementClicked);
+
+    // 创建批量导入按钮（初始隐藏，仅管理员可见）
+    m_importButton = new QPushButton("批量导入", this);
+    m_importButton->setObjectName("importButton");
+    m_importButton->hide();
+    connect(m_importButton, &QPushButton::clicked, this, &MainContentWidget::onUserImportClicked);
     
     // 创建退出登录按钮（右上角）
     m_logoutButton = new QPushButton("退出登录", this);
     m_logoutButton->setObjectName("logoutButton");
     connect(m_logoutButton, &QPushButton::clicked, this, &MainContentWidget::onLogoutButtonClicked);
 
-    // 设置按钮对象名，便于样式设置和权限控制
-    m_functionButton1->setObjectName("functionButton1");
-    m_functionButton2->setObjectName("functionButton2");
-    m_functionButton3->setObjectName("functionButton3");
-    m_functionButton4->setObjectName("functionButton4");
-    m_functionButton5->setObjectName("functionButton5");
+    // 功能按钮网格：按钮在首次设置会话时才生成（见 ensureFunctionButtons）
+    m_buttonsLayout = new QGridLayout();
+    m_buttonsLayout->setContentsMargins(0, 0, 0, 0);
 
-    // 创建垂直布局放置按钮
-    QVBoxLayout *buttonsLayout = new QVBoxLayout();
-    buttonsLayout->setSpacing(50);
-    buttonsLayout->setContentsMargins(0, 0, 0, 0);
-    buttonsLayout->addWidget(m_functionButton1);
-    buttonsLayout->addWidget(m_functionButton2);
-    buttonsLayout->addWidget(m_functionButton3);
-    buttonsLayout->addWidget(m_functionButton4);
-    buttonsLayout->addWidget(m_functionButton5);
+    // 创建中心面板
+    m_centerPanel = new QWidget(this);
+    m_centerPanel->setObjectName("centerPanel");
+    m_centerPanel->setLayout(m_buttonsLayout);
+    m_centerPanel->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
 
-    // 创建中心面板，限制最大宽度
-    QWidget *centerPanel = new QWidget(this);
-    centerPanel->setObjectName("centerPanel");
-    centerPanel->setLayout(buttonsLayout);
-    centerPanel->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
-    centerPanel->setMaximumWidth(400);
-
-    // 用水平布局包裹中心面板，并在两侧添加弹性伸展，确保水平居中
+    // 用水平、垂直伸展包裹中心面板，确保居中；功能较多时在滚动区域内滚动
     QHBoxLayout *hCenter = new QHBoxLayout();
     hCenter->addStretch();
-    hCenter->addWidget(centerPanel);
+    hCenter->addWidget(m_centerPanel);
     hCenter->addStretch();
 
+    QWidget *functionArea = new QWidget(this);
+    functionArea->setObjectName("functionArea");
+    QVBoxLayout *vCenter = new QVBoxLayout(functionArea);
+    vCenter->setContentsMargins(0, 0, 0, 0);
+    vCenter->addStretch();
+    vCenter->addLayout(hCenter);
+    vCenter->addStretch();
+
+    QScrollArea *scrollArea = new QScrollArea(this);
+    scrollArea->setObjectName("functionScrollArea");
+    scrollArea->setFrameShape(QFrame::NoFrame);
+    scrollArea->setWidgetResizable(true);
+    scrollArea->setWidget(functionArea);
+
     // 顶层水平布局：左侧伸展 + 右上角退出登录按钮
     QHBoxLayout *topLayout = new QHBoxLayout();
     topLayout->addStretch();
     topLayout->addWidget(m_logoutButton);
     
-    // 顶层垂直布局：顶部退出登录按钮 + 上方伸展 + 中间按钮 + 下方伸展 + 权限管理按钮（左下角）
+    // 顶层垂直布局：顶部退出登录按钮 + 中间功能按钮区域 + 权限管理按钮（左下角）
     QVBoxLayout *rootLayout = new QVBoxLayout();
     rootLayout->addLayout(topLayout);
-    rootLayout->addStretch();
-    rootLayout->addLayout(hCenter);
-    rootLayout->addStretch();
+    rootLayout->addWidget(scrollArea, 1);
     
-    // 底部水平布局：左侧权限管理按钮 + 右侧伸展
+    // 底部水平布局：左侧权限管理、批量导入按钮 + 右侧伸展
     QHBoxLayout *bottomLayout = new QHBoxLayout();
     bottomLayout->addWidget(m_permissionButton);
+    bottomLayout->addWidget(m_importButton);
     bottomLayout->addStretch();
     rootLayout->addLayout(bottomLayout);
     rootLayout->setContentsMargins(20, 20, 20, 20);
@@ -104,16 +105,6 @@ void MainContentWidget::setupUI()
 
 void MainContentWidget::applyStyles()
 {
-    // 设置按钮字体
-    QFont buttonFont = font();
-    buttonFont.setPointSize(16);  // 比登录界面的按钮字体稍大
-    buttonFont.setBold(true);
-    m_functionButton1->setFont(buttonFont);
-    m_functionButton2->setFont(buttonFont);
-    m_functionButton3->setFont(buttonFont);
-    m_functionButton4->setFont(buttonFont);
-    m_functionButton5->setFont(buttonFont);
-    
     // 设置退出登录按钮字体
     QFont logoutButtonFont = font();
     logoutButtonFont.setPointSize(12);
@@ -121,104 +112,151 @@ void MainContentWidget::applyStyles()
     if (m_logoutButton) {
         m_logoutButton->setFont(logoutButtonFont);
     }
+}
 
-    // 设置按钮尺寸 - 做得更大一些
-    int buttonWidth = 380;
-    int buttonHeight = 88;
-    m_functionButton1->setMinimumSize(buttonWidth, buttonHeight);
-    m_functionButton2->setMinimumSize(buttonWidth, buttonHeight);
-    m_functionButton3->setMinimumSize(buttonWidth, buttonHeight);
-    m_functionButton4->setMinimumSize(buttonWidth, buttonHeight);
-    m_functionButton5->setMinimumSize(buttonWidth, buttonHeight);
+//按功能目录生成功能按钮（只执行一次，目录在程序运行期间不变）
+//按子系统分组：每个子系统从新的一行开始；功能不超过 6 个时保持单列大按钮
+void MainContentWidget::ensureFunctionButtons(const functioncatalog &catalog)
+{
+    if (!m_functionButtons.isEmpty() || catalog.count() == 0) {
+        return;
+    }
 
-    // 设置样式表 - 与登录界面按钮风格一致
-    this->setStyleSheet(
-        "#centerPanel { background: transparent; }"
+    const QList<functioninfo> &functions = catalog.functions();
+    const int columns = qBound(1, (functions.size() + 5) / 6, 4);
+    const bool large = (columns == 1);
 
-        /* 功能按钮：与登录界面按钮相同的样式 */
-        "QPushButton[objectName^=\"functionButton\"] {"
-            "padding: 0 20px;"
-            "border-radius: 10px;"
-            "border: none;"
-            "background: #6CA6CD;"
-            "color: #ffffff;"
-        "}"
-        "QPushButton[objectName^=\"functionButton\"]:hover {"
-            "background: #5B9BD5;"
-        "}"
-        "QPushButton[objectName^=\"functionButton\"]:pressed {"
-            "background: #4A8BC4;"
-        "}"
-        "QPushButton[objectName^=\"functionButton\"]:focus {"
-            "outline: none;"
-            "border: none;"
-        "}"
-        /* 禁用状态的按钮样式（灰色） */
-        "QPushButton[objectName^=\"functionButton\"]:disabled {"
-            "background: #CCCCCC;"
-            "color: #888888;"
-        "}"
-        /* 权限管理按钮样式 */
-        "#permissionButton {"
-            "padding: 8px 16px;"
-            "border-radius: 5px;"
-            "border: none;"
-            "background: #8B7355;"
-            "color: #ffffff;"
-            "font-size: 12px;"
-        "}"
-        "#permissionButton:hover {"
-            "background: #7A6344;"
-        "}"
-        "#permissionButton:pressed {"
-            "background: #6A5334;"
-        "}"
-        /* 退出登录按钮样式 */
-        "#logoutButton {"
-            "padding: 8px 16px;"
-            "border-radius: 5px;"
-            "border: none;"
-            "background: #DC143C;"
-            "color: #ffffff;"
-            "font-size: 12px;"
-        "}"
-        "#logoutButton:hover {"
-            "background: #B22222;"
-        "}"
-        "#logoutButton:pressed {"
-            "background: #8B0000;"
-        "}"
-    );
+    // 设置按钮字体与尺寸（单列时比登录界面的按钮更大一些）
+    QFont buttonFont = font();
+    buttonFont.setPointSize(large ? 16 : 13);
+    buttonFont.setBold(true);
+    const int buttonWidth = large ? 380 : 240;
+    const int buttonHeight = large ? 88 : 64;
+    const int spacing = large ? 50 : 20;
+    m_buttonsLayout->setHorizontalSpacing(spacing);
+    m_buttonsLayout->setVerticalSpacing(spacing);
+
+    int row = 0;
+    int column = 0;
+    for (int i = 0; i < functions.size(); ++i) {
+        const functioninfo &function = functions.at(i);
+        if (i > 0 && function.subsystem != functions.at(i - 1).subsystem && column != 0) {
+            ++row;
+            column = 0;
+        }
+
+        // 对象名 functionButton<id> 便于样式设置和权限控制
+        QPushButton *button = new QPushButton(function.label, m_centerPanel);
+        button->setObjectName(QString("functionButton%1").arg(function.id));
+        button->setFont(buttonFont);
+        button->setMinimumSize(buttonWidth, buttonHeight);
+        button->setEnabled(false);
+        m_buttonsLayout->addWidget(button, row, column);
+        m_functionButtons.append(button);
+        m_functionIds.append(function.id);
+
+        if (++column == columns) {
+            ++row;
+            column = 0;
+        }
+    }
+
+    // 限制中心面板的最大宽度
+    m_centerPanel->setMaximumWidth(columns * buttonWidth + (columns - 1) * spacing + 20);
+}
+
+void MainContentWidget::setSession(AuthManager *authManager, const usersession &session)
+{
+    const quint64 serial = ++m_requestSerial;
+    m_authManager = authManager;
+    m_currentUsername = session.username;
+    
+    // 管理员显示权限管理、批量导入按钮
+    if (m_permissionButton) {
+        m_permissionButton->setVisible(session.isAdmin());
+    }
+    if (m_importButton) {
+        m_importButton->setVisible(session.isAdmin());
+    }
+    
+    qDebug() << "用户" << session.username << "的权限列表:" << session.permissionList();
+    applyPermissionsWhenReady(serial, session.permissions);
 }
 
-void MainContentWidget::updateButtonsByPermissions(AuthManager *authManager, const QString &username)
+void MainContentWidget::updateButtonsByPermissions(AuthManager *authManager, const usersession &session)
 {
     if (!authManager) {
         qDebug() << "AuthManager为空，无法更新按钮权限";
         return;
     }
     
+    const QString username = session.username;
     m_authManager = authManager;
     m_currentUsername = username;
     
-    // 检查是否是管理员（adminjmh）
-    bool isAdmin = (username == "adminjmh");
+    // 按角色判断是否是管理员（与 setSession 一致）
+    bool isAdmin = session.isAdmin();
     
-    // 管理员显示权限管理按钮
+    // 管理员显示权限管理、批量导入按钮
     if (m_permissionButton) {
         m_permissionButton->setVisible(isAdmin);
     }
+    if (m_importButton) {
+        m_importButton->setVisible(isAdmin);
+    }
     
-    // 获取用户的功能权限列表
-    QList<int> permissions = authManager->getUserFunctionPermissions(username);
-    qDebug() << "用户" << username << "的权限列表:" << permissions;
+    // 查询结果返回前先禁用全部功能按钮
+    applyPermissions(0);
     
+    // 在数据库线程中异步获取用户的功能权限列表
+    const quint64 serial = ++m_requestSerial;
+    QFutureWatcher<QList<int>> *watcher = new QFutureWatcher<QList<int>>(this);
+    connect(watcher, &QFutureWatcher<QList<int>>::finished, this, [this, watcher, username, serial]() {
+        watcher->deleteLater();
+        // 请求已被取消（例如已退出登录）
+        if (serial != m_requestSerial) {
+            return;
+        }
+        const QList<int> permissions = watcher->result();
+        qDebug() << "用户" << username << "的权限列表:" << permissions;
+        applyPermissionsWhenReady(serial, functionregistry::fromList(permissions));
+    });
+    watcher->setFuture(authManager->getUserFunctionPermissionsAsync(username));
+}
+
+void MainContentWidget::cancelPendingRequests()
+{
+    ++m_requestSerial;
+    m_currentUsername.clear();
+    applyPermissions(0);
+}
+
+void MainContentWidget::applyPermissionsWhenReady(quint64 serial, permmask permissions)
+{
+    if (!m_functionButtons.isEmpty() || !m_authManager) {
+        applyPermissions(permissions);
+        return;
+    }
+    
+    // 功能按钮尚未生成：在数据库线程中取得功能目录（未缓存时需要查询），返回后生成按钮再应用权限
+    QFutureWatcher<functioncatalog> *watcher = new QFutureWatcher<functioncatalog>(this);
+    connect(watcher, &QFutureWatcher<functioncatalog>::finished, this, [this, watcher, serial, permissions]() {
+        watcher->deleteLater();
+        ensureFunctionButtons(watcher->result());
+        // 请求已被取消（例如已退出登录）时按钮保持禁用
+        if (serial == m_requestSerial) {
+            applyPermissions(permissions);
+        }
+    });
+    watcher->setFuture(m_authManager->getFunctionCatalogAsync());
+}
+
+void MainContentWidget::applyPermissions(permmask permissions)
+{
     // 更新每个按钮的状态
-    updateButtonState(m_functionButton1, permissions.contains(1));
-    updateButtonState(m_functionButton2, permissions.contains(2));
-    updateButtonState(m_functionButton3, permissions.contains(3));
-    updateButtonState(m_functionButton4, permissions.contains(4));
-    updateButtonState(m_functionButton5, permissions.contains(5));
+    for (int i = 0; i < m_functionButtons.size(); ++i) {
+        updateButtonState(m_functionButtons.at(i), functionregistry::has(permissions, m_functionIds.at(i)));
+    }
 }
 
 void MainContentWidget::onPermissionManagementClicked()
@@ -226,6 +264,11 @@ void MainContentWidget::onPermissionManagementClicked()
     emit permissionManagementRequested();
 }
 
+void MainContentWidget::onUserImportClicked()
+{
+    emit userImportRequested();
+}
+
 void MainContentWidget::onLogoutButtonClicked()
 {
     // 显示确认对话框
@@ -253,52 +296,22 @@ void MainContentWidget::updateButtonState(QPushButton *button, bool enabled)
 
 void MainContentWidget::setBackgroundImage()
 {
-    QString startDir = QCoreApplication::applicationDirPath();
-
-    QString path;
-    QString curDir = startDir;
-    for (int level = 0; level < 6 && path.isEmpty(); ++level) {
-        const QString base = curDir + "/resources/";
-        const QString jpg = base + "loginWidget.jpg";
-        const QString png = base + "loginWidget.png";
-        const bool jpgExists = QFile::exists(jpg);
-        const bool pngExists = QFile::exists(png);
-        if (jpgExists) {
-            path = jpg;
-            break;
-        }
-        if (pngExists) {
-            path = png;
-            break;
-        }
-        // 上移一层
-        curDir = QDir::cleanPath(curDir + "/..");
-    }
-
-    // 使用样式表 border-image 自适应填充，随窗口变化自动缩放
-    if (!path.isEmpty()) {
-        QPixmap probe(path); 
-        if (!probe.isNull()) {
-            m_bgPixmap = probe;
-            update(); // 触发重绘
-        }
-
-        // 叠加样式，避免覆盖先前的控件样式
-        const QString prev = this->styleSheet();
-        this->setStyleSheet(prev + "\n" + QString(
-            "border-image: url(%1) 0 0 0 0 stretch stretch;"
-        ).arg(path));
-    }
+    // 背景图只在 paintEvent 中绘制一次（不再叠加 border-image 样式，避免重复绘制与整页样式重算）
+    // 图片由共享的 BackgroundImageCache 在后台解码并按尺寸缓存，解码完成后重绘
+    connect(BackgroundImageCache::instance(), &BackgroundImageCache::imageReady, this, [this]() {
+        update();
+    });
 }
 
 void MainContentWidget::paintEvent(QPaintEvent *event)
 {
-    if (!m_bgPixmap.isNull()) {
+    painttimer timer("main");
+    // 直接贴上当前尺寸的成品（已缩放并叠加透明度），尺寸不变时不再缩放
+    const QPixmap background = BackgroundImageCache::instance()->pixmap(
+        size(), devicePixelRatioF(), palette().color(QPalette::Window));
+    if (!background.isNull()) {
         QPainter p(this);
-        p.setRenderHint(QPainter::SmoothPixmapTransform, true);
-        const qreal opacity = 0.6;  // 与登录界面相同的透明度
-        p.setOpacity(opacity);
-        p.drawPixmap(rect(), m_bgPixmap);
+        p.drawPixmap(0, 0, background);
     }
     QWidget::paintEvent(event);
 }
@@ -3,8 +3,11 @@
 #include <QWidget>
 #include <QPixmap>
 #include <QList>
+#include "../auth/usersession.h"
+#include "../database/functioncatalog.h"
 
 class QPushButton;
+class QGridLayout;
 class AuthManager;
 
 class MainContentWidget : public QWidget
@@ -14,12 +17,20 @@ class MainContentWidget : public QWidget
 public:
     MainContentWidget(QWidget *parent = nullptr);
     
-    // 根据用户权限更新按钮状态
-    void updateButtonsByPermissions(AuthManager *authManager, const QString &username);
+    // 根据登录会话更新按钮状态（会话中已包含权限，无需再查询数据库）
+    void setSession(AuthManager *authManager, const usersession &session);
+
+    // 根据用户权限更新按钮状态（异步重新查询功能权限，结果返回前功能按钮保持禁用；角色取自会话）
+    void updateButtonsByPermissions(AuthManager *authManager, const usersession &session);
+
+    // 取消尚未返回的权限查询（退出登录时调用）
+    void cancelPendingRequests();
 
 signals:
     // 权限管理按钮点击信号
     void permissionManagementRequested();
+    // 批量导入用户按钮点击信号
+    void userImportRequested();
     // 退出登录信号
     void logoutRequested();
 
@@ -29,6 +40,7 @@ protected:
 
 private slots:
     void onPermissionManagementClicked();
+    void onUserImportClicked();
     void onLogoutButtonClicked();
 
 private:
@@ -36,19 +48,25 @@ private:
     void applyStyles();
     void setBackgroundImage();
     void updateButtonState(QPushButton *button, bool enabled);
+    void applyPermissions(permmask permissions);
+    // 功能按钮已生成时直接应用权限，否则先异步取得功能目录生成按钮（serial 已过期时不应用）
+    void applyPermissionsWhenReady(quint64 serial, permmask permissions);
+
+    // 首次需要时按功能目录生成功能按钮（构造页面时不创建，启动耗时与功能数量无关）
+    void ensureFunctionButtons(const functioncatalog &catalog);
 
 private:
     AuthManager *m_authManager;
     QString m_currentUsername;
     
-    QPushButton *m_functionButton1;
-    QPushButton *m_functionButton2;
-    QPushButton *m_functionButton3;
-    QPushButton *m_functionButton4;
-    QPushButton *m_functionButton5;
+    QWidget *m_centerPanel;          // 功能按钮网格
+    QGridLayout *m_buttonsLayout;
+    QList<QPushButton*> m_functionButtons;  // 按功能目录的顺序
+    QList<int> m_functionIds;               // 与 m_functionButtons 一一对应
     QPushButton *m_permissionButton;  // 权限管理按钮
+    QPushButton *m_importButton;  // 批量导入按钮
     QPushButton *m_logoutButton;  // 退出登录按钮
-    QPixmap m_bgPixmap;
+    quint64 m_requestSerial;  // 请求序号，用于丢弃已取消请求的结果
 };
 
 #endif // MAINCONTENTWIDGET_H
@@ -0,0 +1,83 @@
+#include "permissioncheckdelegate.h"
+#include <QApplication>
+#include <QStyle>
+#include <QStyleOptionButton>
+#include <QPainter>
+#include <QMouseEvent>
+#include <QKeyEvent>
+
+PermissionCheckDelegate::PermissionCheckDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void PermissionCheckDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const QVariant state = index.data(Qt::CheckStateRole);
+    if (!state.isValid()) {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+
+    // 先绘制单元格背景（不绘制默认的左对齐复选框与文字）
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    opt.features &= ~QStyleOptionViewItem::HasCheckIndicator;
+    opt.text.clear();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    // 再在中央绘制复选框
+    QStyleOptionButton checkBox;
+    checkBox.rect = checkBoxRect(option);
+    checkBox.state = QStyle::State_Enabled;
+    checkBox.state |= (state.toInt() == Qt::Checked) ? QStyle::State_On : QStyle::State_Off;
+    style->drawPrimitive(QStyle::PE_IndicatorCheckBox, &checkBox, painter, widget);
+}
+
+bool PermissionCheckDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                          const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    const Qt::ItemFlags itemFlags = index.flags();
+    if (!(itemFlags & Qt::ItemIsUserCheckable) || !(itemFlags & Qt::ItemIsEnabled)) {
+        return false;
+    }
+
+    switch (event->type()) {
+    case QEvent::MouseButtonRelease: {
+        // 点击单元格任意位置均可切换
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent*>(event);
+        if (mouseEvent->button() != Qt::LeftButton || !option.rect.contains(mouseEvent->pos())) {
+            return false;
+        }
+        break;
+    }
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonDblClick:
+        // 吞掉按下与双击，避免重复切换
+        return true;
+    case QEvent::KeyPress: {
+        QKeyEvent *keyEvent = static_cast<QKeyEvent*>(event);
+        if (keyEvent->key() != Qt::Key_Space && keyEvent->key() != Qt::Key_Select) {
+            return false;
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+
+    const bool checked = (index.data(Qt::CheckStateRole).toInt() == Qt::Checked);
+    return model->setData(index, checked ? Qt::Unchecked : Qt::Checked, Qt::CheckStateRole);
+}
+
+QRect PermissionCheckDelegate::checkBoxRect(const QStyleOptionViewItem &option) const
+{
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    const QSize size(style->pixelMetric(QStyle::PM_IndicatorWidth, &option, widget),
+                     style->pixelMetric(QStyle::PM_IndicatorHeight, &option, widget));
+    return QStyle::alignedRect(option.direction, Qt::AlignCenter, size, option.rect);
+}
@@ -0,0 +1,25 @@
+#ifndef PERMISSIONCHECKDELEGATE_H
+#define PERMISSIONCHECKDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+// 权限复选框委托：在单元格中央直接绘制复选框，点击单元格切换勾选状态
+class PermissionCheckDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit PermissionCheckDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    // 复选框在单元格中的位置（居中）
+    QRect checkBoxRect(const QStyleOptionViewItem &option) const;
+};
+
+#endif // PERMISSIONCHECKDELEGATE_H
@@ -2,61 +2,85 @@
 #include "../auth/authmanager.h"
 #include "../auth/userinfo.h"
 #include "../database/databasemanager.h"
+#include "permissionmatrixmodel.h"
+#include "permissioncheckdelegate.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
-#include <QTableWidgetItem>
-#include <QCheckBox>
 #include <QMessageBox>
 #include <QDebug>
-#include <QSqlQuery>
-#include <QSqlDatabase>
+#include <QFileDialog>
+#include <QProgressDialog>
+#include <QPointer>
+#include <QCoreApplication>
+#include <QtConcurrent/QtConcurrentRun>
 
 PermissionManagementWidget::PermissionManagementWidget(AuthManager *authManager, QWidget *parent)
     : QDialog(parent)
     , m_authManager(authManager)
     , m_userTable(nullptr)
+    , m_model(nullptr)
     , m_saveButton(nullptr)
     , m_cancelButton(nullptr)
+    , m_exportButton(nullptr)
+    , m_loadWatcher(new QFutureWatcher<permissionmatrix>(this))
+    , m_saveWatcher(new QFutureWatcher<authresult>(this))
+    , m_savingCount(0)
+    , m_exportWatcher(new QFutureWatcher<exportsummary>(this))
+    , m_exportProgress(nullptr)
 {
     setWindowTitle("用户权限管理");
     setMinimumSize(700, 500);
     setupUI();
+    connect(m_loadWatcher, &QFutureWatcher<permissionmatrix>::finished, this, &PermissionManagementWidget::onUsersLoaded);
+    connect(m_saveWatcher, &QFutureWatcher<authresult>::finished, this, &PermissionManagementWidget::onSaveFinished);
     loadUsers();
+    connect(m_exportWatcher, &QFutureWatcher<exportsummary>::finished, this, &PermissionManagementWidget::onExportFinished);
+}
+
+PermissionManagementWidget::~PermissionManagementWidget()
+{
+    // 导出任务引用了 m_exporter，必须等待其结束
+    if (m_exportWatcher->isRunning()) {
+        m_exporter->cancel();
+        m_exportWatcher->waitForFinished();
+    }
 }
 
 void PermissionManagementWidget::setupUI()
 {
-    // 创建表格
-    m_userTable = new QTableWidget(this);
-    m_userTable->setColumnCount(7);
-    QStringList headers;
-    headers << "用户名" << "邮箱" << "功能一" << "功能二" << "功能三" << "功能四" << "功能五";
-    m_userTable->setHorizontalHeaderLabels(headers);
+    // 创建表格（模型/视图：只绘制可见行，复选框由委托直接绘制）
+    // 功能列随用户列表一起在数据库线程中读取（见 onUsersLoaded）
+    m_model = new PermissionMatrixModel(this);
+    m_userTable = new QTableView(this);
+    m_userTable->setModel(m_model);
+    m_userTable->setItemDelegate(new PermissionCheckDelegate(m_userTable));
     m_userTable->setSelectionMode(QAbstractItemView::NoSelection);  // 禁用选择
     m_userTable->setSelectionBehavior(QAbstractItemView::SelectItems);  // 即使设置了NoSelection，这个也要设置
     m_userTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     m_userTable->setFocusPolicy(Qt::NoFocus);  // 禁用焦点，避免选中效果
     
-    // 设置列宽调整策略
-    m_userTable->horizontalHeader()->setSectionResizeMode(COL_USERNAME, QHeaderView::Fixed);
-    m_userTable->horizontalHeader()->setSectionResizeMode(COL_EMAIL, QHeaderView::Fixed);
-    for (int i = COL_FUNC1; i <= COL_FUNC5; ++i) {
-        m_userTable->horizontalHeader()->setSectionResizeMode(i, QHeaderView::Stretch);
-    }
+    // 固定行高：视图无需逐行计算高度，行数再多滚动也只处理可见区域
+    m_userTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_userTable->verticalHeader()->setDefaultSectionSize(28);
+    m_userTable->horizontalHeader()->setMinimumSectionSize(72);
+
     
     // 创建按钮
     m_saveButton = new QPushButton("保存", this);
     m_cancelButton = new QPushButton("取消", this);
+    m_exportButton = new QPushButton("导出CSV", this);
     
     connect(m_saveButton, &QPushButton::clicked, this, &PermissionManagementWidget::onSaveClicked);
     connect(m_cancelButton, &QPushButton::clicked, this, &PermissionManagementWidget::onCancelClicked);
+    connect(m_exportButton, &QPushButton::clicked, this, &PermissionManagementWidget::onExportClicked);
     
     // 布局
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->addWidget(m_userTable);
     
     QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(m_exportButton);
     buttonLayout->addStretch();
     buttonLayout->addWidget(m_saveButton);
     buttonLayout->addWidget(m_cancelButton);
@@ -66,7 +90,7 @@ void PermissionManagementWidget::setupUI()
 
 void PermissionManagementWidget::loadUsers()
 {
-    if (!m_authManager) {
+    if (!m_authManager || m_loadWatcher->isRunning()) {
         return;
     }
     
@@ -77,54 +101,47 @@ void PermissionManagementWidget::loadUsers()
         return;
     }
     
-    QSqlDatabase db = dbManager->getDatabase();
-    
-    // 查询所有用户（排除adminjmh，因为管理员权限不能修改）
-    QSqlQuery query(db);
-    query.prepare("SELECT userid, username, email FROM NowUsers WHERE username != ? ORDER BY username");
-    query.addBindValue("adminjmh");
-    
-    QList<QPair<int, QString>> users;  // userid, username
-    if (query.exec()) {
-        while (query.next()) {
-            int userId = query.value(0).toInt();
-            QString username = query.value(1).toString();
-            QString email = query.value(2).toString();
-            users.append(qMakePair(userId, username));
-            
-            // 添加到表格
-            int row = m_userTable->rowCount();
-            m_userTable->insertRow(row);
-            
-            // 用户名（只读，不可选择）
-            QTableWidgetItem *usernameItem = new QTableWidgetItem(username);
-            usernameItem->setFlags(usernameItem->flags() & ~Qt::ItemIsEditable & ~Qt::ItemIsSelectable);
-            m_userTable->setItem(row, COL_USERNAME, usernameItem);
-            
-            // 邮箱（只读，不可选择）
-            QTableWidgetItem *emailItem = new QTableWidgetItem(email);
-            emailItem->setFlags(emailItem->flags() & ~Qt::ItemIsEditable & ~Qt::ItemIsSelectable);
-            m_userTable->setItem(row, COL_EMAIL, emailItem);
-            
-            // 获取用户的功能权限
-            QList<int> permissions = m_authManager->getUserFunctionPermissions(username);
-            
-            // 功能权限复选框（5个功能）
-            for (int funcId = 1; funcId <= 5; ++funcId) {
-                QCheckBox *checkBox = new QCheckBox(this);
-                checkBox->setChecked(permissions.contains(funcId));
-                m_userTable->setCellWidget(row, COL_FUNC1 + funcId - 1, checkBox);
-            }
-        }
+    // 在数据库线程中一次查询取回所有用户及其功能权限掩码（排除adminjmh，因为管理员权限不能修改）
+    setBusy(true);
+    m_loadWatcher->setFuture(m_authManager->getPermissionMatrixAsync("adminjmh"));
+}
+
+void PermissionManagementWidget::onUsersLoaded()
+{
+    const permissionmatrix matrix = m_loadWatcher->result();
+    setBusy(false);
+    if (!matrix.success) {
+        QMessageBox::warning(this, "错误", matrix.error);
+        return;
+    }
+    
+    // 填充模型（加载完成后一次性通知视图）
+    m_model->setFunctions(matrix.catalog.functions());
+    m_model->beginLoad();
+    for (const permissionrow &row : matrix.rows) {
+        m_model->appendUser(row.userId, row.username, row.email, row.mask);
+    }
+    m_model->endLoad();
+    
+    // 设置列宽调整策略（模型重置会清除表头的分段设置，因此在加载后设置）
+    m_userTable->horizontalHeader()->setSectionResizeMode(PermissionMatrixModel::COL_USERNAME, QHeaderView::Fixed);
+    m_userTable->horizontalHeader()->setSectionResizeMode(PermissionMatrixModel::COL_EMAIL, QHeaderView::Fixed);
+    for (int i = 0; i < m_model->functionCount(); ++i) {
+        m_userTable->horizontalHeader()->setSectionResizeMode(PermissionMatrixModel::COL_FUNC1 + i, QHeaderView::Stretch);
     }
     
     // 设置列宽
     // 用户名和邮箱列设置固定宽度（较宽）
-    m_userTable->setColumnWidth(COL_USERNAME, 150);
-    m_userTable->setColumnWidth(COL_EMAIL, 200);
+    m_userTable->setColumnWidth(PermissionMatrixModel::COL_USERNAME, 150);
+    m_userTable->setColumnWidth(PermissionMatrixModel::COL_EMAIL, 200);
     
-    // 功能一到功能五列使用Stretch模式，会自动均分剩余宽度
-    // 已经在setupUI中设置了Stretch模式，这里不需要再设置宽度
+    // 功能列使用Stretch模式，会自动均分剩余宽度（不小于最小列宽，功能较多时出现水平滚动条）
+}
+
+void PermissionManagementWidget::setBusy(bool busy)
+{
+    m_userTable->setEnabled(!busy);
+    m_saveButton->setEnabled(!busy);
 }
 
 void PermissionManagementWidget::onSaveClicked()
@@ -133,6 +150,9 @@ void PermissionManagementWidget::onSaveClicked()
         QMessageBox::warning(this, "错误", "认证管理器未初始化！");
         return;
     }
+    if (m_loadWatcher->isRunning() || m_saveWatcher->isRunning()) {
+        return;
+    }
     
     // 获取数据库管理器
     databasemanager *dbManager = m_authManager->getDatabaseManager();
@@ -141,85 +161,32 @@ void PermissionManagementWidget::onSaveClicked()
         return;
     }
     
-    QSqlDatabase db = dbManager->getDatabase();
-    int successCount = 0;
-    int failCount = 0;
-    
-    // 遍历所有行，保存权限
-    for (int i = 0; i < m_userTable->rowCount(); ++i) {
-        QTableWidgetItem *usernameItem = m_userTable->item(i, COL_USERNAME);
-        if (!usernameItem) continue;
-        
-        QString username = usernameItem->text();
-        
-        // 获取userid
-        QSqlQuery userQuery(db);
-        userQuery.prepare("SELECT userid FROM NowUsers WHERE username = ?");
-        userQuery.addBindValue(username);
-        int userId = -1;
-        if (userQuery.exec() && userQuery.next()) {
-            userId = userQuery.value(0).toInt();
-        }
-        userQuery.finish();
-        
-        if (userId <= 0) continue;
-        
-        // 更新功能权限
-        for (int funcId = 1; funcId <= 5; ++funcId) {
-            QCheckBox *checkBox = qobject_cast<QCheckBox*>(m_userTable->cellWidget(i, COL_FUNC1 + funcId - 1));
-            if (checkBox) {
-                bool enabled = checkBox->isChecked();
-                
-                // 先检查权限记录是否存在
-                QSqlQuery checkQuery(db);
-                checkQuery.prepare("SELECT COUNT(*) FROM NowUsersPermissions WHERE userid = ? AND function_id = ?");
-                checkQuery.addBindValue(userId);
-                checkQuery.addBindValue(funcId);
-                bool exists = false;
-                if (checkQuery.exec() && checkQuery.next()) {
-                    exists = checkQuery.value(0).toInt() > 0;
-                }
-                checkQuery.finish();
-                
-                QSqlQuery updateQuery(db);
-                if (exists) {
-                    // 更新现有记录
-                    updateQuery.prepare("UPDATE NowUsersPermissions SET enabled = ? WHERE userid = ? AND function_id = ?");
-                    updateQuery.addBindValue(enabled ? 1 : 0);
-                    updateQuery.addBindValue(userId);
-                    updateQuery.addBindValue(funcId);
-                } else {
-                    // 插入新记录
-                    updateQuery.prepare("INSERT INTO NowUsersPermissions (userid, function_id, enabled) VALUES (?, ?, ?)");
-                    updateQuery.addBindValue(userId);
-                    updateQuery.addBindValue(funcId);
-                    updateQuery.addBindValue(enabled ? 1 : 0);
-                }
-                
-                if (updateQuery.exec()) {
-                    successCount++;
-                } else {
-                    failCount++;
-                    qDebug() << "更新权限失败:" << username << "功能" << funcId << updateQuery.lastError().text();
-                }
-                updateQuery.finish();
-            }
-        }
+    // 只保存管理员实际切换过的单元格
+    const QList<permissionchange> changes = m_model->changes();
+    if (changes.isEmpty()) {
+        QMessageBox::information(this, "保存成功", "没有需要保存的修改。");
+        accept();
+        return;
     }
     
-    // 提交事务
-    if (!db.commit()) {
-        QMessageBox::warning(this, "保存失败", QString("提交事务失败: %1").arg(db.lastError().text()));
+    // 在数据库线程中一个事务内批量写入
+    m_savingCount = changes.size();
+    setBusy(true);
+    m_saveWatcher->setFuture(m_authManager->savePermissionChangesAsync(changes));
+}
+
+void PermissionManagementWidget::onSaveFinished()
+{
+    const authresult result = m_saveWatcher->result();
+    setBusy(false);
+    if (!result.success) {
+        QMessageBox::warning(this, "保存失败", result.error);
         return;
     }
     
-    if (failCount > 0) {
-        QMessageBox::warning(this, "保存结果", 
-            QString("保存完成，成功：%1项，失败：%2项").arg(successCount).arg(failCount));
-    } else {
-        QMessageBox::information(this, "保存成功", "所有权限已成功保存！");
-        accept();  // 关闭对话框
-    }
+    m_model->markSaved();
+    QMessageBox::information(this, "保存成功", QString("所有权限已成功保存！（共%1项修改）").arg(m_savingCount));
+    accept();  // 关闭对话框
 }
 
 void PermissionManagementWidget::onCancelClicked()
@@ -227,3 +194,71 @@ void PermissionManagementWidget::onCancelClicked()
     reject();  // 关闭对话框
 }
 
+
+// 导出全部用户的权限矩阵（直接从数据库流式导出，不经过表格模型）
+void PermissionManagementWidget::onExportClicked()
+{
+    if (!m_authManager || m_exportWatcher->isRunning()) {
+        return;
+    }
+
+    const QString path = QFileDialog::getSaveFileName(this, "导出权限矩阵", "permissions.csv", "CSV 文件 (*.csv)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    m_exporter.reset(new permissionexporter(m_authManager->getDatabaseManager()));
+
+    // 总数在导出开始后才知道，之前显示为忙碌状态
+    m_exportProgress = new QProgressDialog("正在导出...", "取消", 0, 0, this);
+    m_exportProgress->setWindowTitle("导出权限矩阵");
+    m_exportProgress->setWindowModality(Qt::WindowModal);
+    m_exportProgress->setMinimumDuration(0);
+    m_exportProgress->setAutoClose(false);
+    m_exportProgress->setAutoReset(false);
+    permissionexporter *exporter = m_exporter.get();
+    connect(m_exportProgress, &QProgressDialog::canceled, this, [exporter]() {
+        exporter->cancel();
+    });
+
+    // 进度在导出线程中回调，投递到界面线程更新
+    QPointer<QProgressDialog> progressDialog(m_exportProgress);
+    m_exporter->setProgressCallback([progressDialog](const exportprogress &progress) {
+        QMetaObject::invokeMethod(qApp, [progressDialog, progress]() {
+            if (!progressDialog || progressDialog->wasCanceled()) {
+                return;
+            }
+            // QProgressDialog 的范围是 int，按千分比显示
+            if (progress.usersTotal > 0) {
+                progressDialog->setMaximum(1000);
+                progressDialog->setValue(int(qMin<qint64>(1000, progress.usersWritten * 1000 / progress.usersTotal)));
+            }
+            progressDialog->setLabelText(QString("已导出 %1 / %2 个用户").arg(progress.usersWritten).arg(progress.usersTotal));
+        }, Qt::QueuedConnection);
+    });
+
+    m_exportButton->setEnabled(false);
+    m_exportWatcher->setFuture(QtConcurrent::run([exporter, path]() {
+        return exporter->exportFile(path);
+    }));
+}
+
+void PermissionManagementWidget::onExportFinished()
+{
+    const exportsummary summary = m_exportWatcher->result();
+    m_exportButton->setEnabled(true);
+    if (m_exportProgress) {
+        m_exportProgress->deleteLater();
+        m_exportProgress = nullptr;
+    }
+
+    if (summary.cancelled) {
+        return;
+    }
+    if (!summary.success) {
+        QMessageBox::warning(this, "导出失败", summary.error);
+        return;
+    }
+    QMessageBox::information(this, "导出成功", QString("已导出 %1 个用户，用时 %2 秒。")
+                             .arg(summary.progress.usersWritten).arg(summary.elapsedMs / 1000.0, 0, 'f', 1));
+}
@@ -2,10 +2,17 @@
 #define PERMISSIONMANAGEMENTWIDGET_H
 
 #include <QDialog>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
+#include <QFutureWatcher>
+#include <memory>
+#include "../auth/permissionexporter.h"
 
 class AuthManager;
+class PermissionMatrixModel;
+struct permissionmatrix;
+struct authresult;
+class QProgressDialog;
 
 class PermissionManagementWidget : public QDialog
 {
@@ -13,28 +20,38 @@ class PermissionManagementWidget : public QDialog
 
 public:
     explicit PermissionManagementWidget(AuthManager *authManager, QWidget *parent = nullptr);
+    ~PermissionManagementWidget() override;
 
 private slots:
+    void onUsersLoaded();
     void onSaveClicked();
+    void onSaveFinished();
     void onCancelClicked();
+    void onExportClicked();
+    void onExportFinished();
 
 private:
     void setupUI();
     void loadUsers();
+    // 数据库请求进行中时禁用表格与保存按钮
+    void setBusy(bool busy);
     
     AuthManager *m_authManager;
-    QTableWidget *m_userTable;
+    QTableView *m_userTable;
+    PermissionMatrixModel *m_model;  // 用户权限矩阵（列索引见模型定义）
     QPushButton *m_saveButton;
     QPushButton *m_cancelButton;
-    
-    // 列索引
-    static const int COL_USERNAME = 0;
-    static const int COL_EMAIL = 1;
-    static const int COL_FUNC1 = 2;
-    static const int COL_FUNC2 = 3;
-    static const int COL_FUNC3 = 4;
-    static const int COL_FUNC4 = 5;
-    static const int COL_FUNC5 = 6;
+    QPushButton *m_exportButton;
+
+    // 用户列表读取与权限保存（数据库线程执行，结果在界面线程应用）
+    QFutureWatcher<permissionmatrix> *m_loadWatcher;
+    QFutureWatcher<authresult> *m_saveWatcher;
+    int m_savingCount;   // 正在保存的修改项数
+
+    // 权限矩阵导出（后台线程执行，可取消）
+    std::unique_ptr<permissionexporter> m_exporter;
+    QFutureWatcher<exportsummary> *m_exportWatcher;
+    QProgressDialog *m_exportProgress;
 };
 
 #endif // PERMISSIONMANAGEMENTWIDGET_H
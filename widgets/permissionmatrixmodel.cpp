@@ -0,0 +1,203 @@
+#include "permissionmatrixmodel.h"
+#include "../auth/authmanager.h"
+
+PermissionMatrixModel::PermissionMatrixModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_functionMask(0)
+{
+}
+
+void PermissionMatrixModel::setFunctions(const QList<functioninfo> &functions)
+{
+    beginResetModel();
+    clearRows();
+    m_functions = functions;
+    m_functionMask = 0;
+    for (const functioninfo &function : m_functions) {
+        m_functionMask |= functionregistry::bit(function.id);
+    }
+    endResetModel();
+}
+
+int PermissionMatrixModel::functionCount() const
+{
+    return m_functions.size();
+}
+
+permmask PermissionMatrixModel::functionMask() const
+{
+    return m_functionMask;
+}
+
+int PermissionMatrixModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_userIds.size();
+}
+
+int PermissionMatrixModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : COL_FUNC1 + m_functions.size();
+}
+
+QVariant PermissionMatrixModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_userIds.size()) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+    const int column = index.column();
+    if (column == COL_USERNAME && role == Qt::DisplayRole) {
+        return m_usernames.at(row);
+    }
+    if (column == COL_EMAIL && role == Qt::DisplayRole) {
+        return m_emails.at(row);
+    }
+    if (column >= COL_FUNC1 && role == Qt::CheckStateRole) {
+        return isEnabled(row, functionIdAt(column)) ? Qt::Checked : Qt::Unchecked;
+    }
+    return QVariant();
+}
+
+bool PermissionMatrixModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || index.column() < COL_FUNC1 || role != Qt::CheckStateRole) {
+        return false;
+    }
+
+    const int row = index.row();
+    const permmask bit = functionregistry::bit(functionIdAt(index.column()));
+    const bool enabled = (value.toInt() == Qt::Checked);
+    if (enabled) {
+        m_masks[row] |= bit;
+    } else {
+        m_masks[row] &= ~bit;
+    }
+    if (m_masks.at(row) != m_savedMasks.at(row)) {
+        m_dirtyRows.insert(row);
+    } else {
+        m_dirtyRows.remove(row);
+    }
+    emit dataChanged(index, index, QVector<int>() << Qt::CheckStateRole);
+    return true;
+}
+
+QVariant PermissionMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical) {
+        return section + 1;
+    }
+
+    if (section == COL_USERNAME) {
+        return QString("用户名");
+    }
+    if (section == COL_EMAIL) {
+        return QString("邮箱");
+    }
+    const int index = section - COL_FUNC1;
+    return (index >= 0 && index < m_functions.size()) ? m_functions.at(index).label : QString();
+}
+
+Qt::ItemFlags PermissionMatrixModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    // 用户名、邮箱只读且不可选择；功能列可勾选
+    if (index.column() >= COL_FUNC1) {
+        return Qt::ItemIsEnabled | Qt::ItemIsUserCheckable;
+    }
+    return Qt::ItemIsEnabled;
+}
+
+void PermissionMatrixModel::beginLoad()
+{
+    beginResetModel();
+    clearRows();
+}
+
+int PermissionMatrixModel::appendUser(int userId, const QString &username, const QString &email, permmask mask)
+{
+    m_userIds.append(userId);
+    m_usernames.append(username);
+    m_emails.append(email);
+    m_masks.append(mask & m_functionMask);
+    return m_userIds.size() - 1;
+}
+
+void PermissionMatrixModel::endLoad()
+{
+    m_userIds.squeeze();
+    m_usernames.squeeze();
+    m_emails.squeeze();
+    m_masks.squeeze();
+    m_savedMasks = m_masks;
+    endResetModel();
+}
+
+int PermissionMatrixModel::userId(int row) const
+{
+    return m_userIds.value(row, -1);
+}
+
+QString PermissionMatrixModel::username(int row) const
+{
+    return m_usernames.value(row);
+}
+
+bool PermissionMatrixModel::isEnabled(int row, int functionId) const
+{
+    return functionregistry::has(m_masks.value(row, 0), functionId);
+}
+
+bool PermissionMatrixModel::hasChanges() const
+{
+    return !m_dirtyRows.isEmpty();
+}
+
+// 只返回实际被切换过的单元格
+QList<permissionchange> PermissionMatrixModel::changes() const
+{
+    QList<permissionchange> result;
+    for (int row : m_dirtyRows) {
+        const permmask diff = m_masks.at(row) ^ m_savedMasks.at(row);
+        for (const functioninfo &function : m_functions) {
+            if (functionregistry::has(diff, function.id)) {
+                permissionchange change;
+                change.userId = m_userIds.at(row);
+                change.functionId = function.id;
+                change.enabled = isEnabled(row, function.id);
+                result.append(change);
+            }
+        }
+    }
+    return result;
+}
+
+void PermissionMatrixModel::markSaved()
+{
+    m_savedMasks = m_masks;
+    m_dirtyRows.clear();
+}
+
+int PermissionMatrixModel::functionIdAt(int column) const
+{
+    const int index = column - COL_FUNC1;
+    if (index < 0 || index >= m_functions.size()) {
+        return 0;
+    }
+    return m_functions.at(index).id;
+}
+
+void PermissionMatrixModel::clearRows()
+{
+    m_userIds.clear();
+    m_usernames.clear();
+    m_emails.clear();
+    m_masks.clear();
+    m_savedMasks.clear();
+    m_dirtyRows.clear();
+}
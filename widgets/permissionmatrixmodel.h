@@ -0,0 +1,72 @@
+#ifndef PERMISSIONMATRIXMODEL_H
+#define PERMISSIONMATRIXMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QString>
+#include <QSet>
+#include <QList>
+#include "../database/functioncatalog.h"
+
+struct permissionchange;
+
+// 用户权限矩阵模型：每个用户只保存 userid、用户名、邮箱与一个功能位掩码，
+// 由视图按需读取可见行，不为每个单元格创建控件；功能列由功能目录决定
+class PermissionMatrixModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    // 列索引
+    static const int COL_USERNAME = 0;
+    static const int COL_EMAIL = 1;
+    static const int COL_FUNC1 = 2;   // 第一个功能列，之后按功能目录的顺序每个功能一列
+
+    explicit PermissionMatrixModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    // 设置功能列（重置模型，已加载的数据被清空）
+    void setFunctions(const QList<functioninfo> &functions);
+    int functionCount() const;
+
+    // 全部功能列的掩码
+    permmask functionMask() const;
+
+    // 批量加载：beginLoad 清空模型，appendUser 写入数据，endLoad 通知视图
+    void beginLoad();
+    int appendUser(int userId, const QString &username, const QString &email, permmask mask);
+    void endLoad();
+
+    // 列对应的 function_id（非功能列返回 0）
+    int functionIdAt(int column) const;
+
+    // 读取接口
+    int userId(int row) const;
+    QString username(int row) const;
+    bool isEnabled(int row, int functionId) const;
+
+    // 修改跟踪：只有与加载时不同的单元格才需要保存
+    bool hasChanges() const;
+    QList<permissionchange> changes() const;
+    void markSaved();
+
+private:
+    void clearRows();
+
+    QList<functioninfo> m_functions;
+    permmask m_functionMask;
+    QVector<int> m_userIds;
+    QVector<QString> m_usernames;
+    QVector<QString> m_emails;
+    QVector<permmask> m_masks;       // 与 NowUsers.perm_mask 相同的位布局
+    QVector<permmask> m_savedMasks;  // 加载（或上次保存）时的掩码
+    QSet<int> m_dirtyRows;         // 掩码与保存值不同的行
+};
+
+#endif // PERMISSIONMATRIXMODEL_H
@@ -1,4 +1,7 @@
 #include "registerwidget.h"
+#include "backgroundimagecache.h"
+#include "apptheme.h"
+#include "../metrics/rendermetrics.h"
 
 #include <QLabel>
 #include <QLineEdit>
@@ -11,15 +14,14 @@
 #include <QPainter>
 #include <QPaintEvent>
 #include <QPixmap>
-#include <QFileInfo>
-#include <QFile>
-#include <QCoreApplication>
 #include <QDebug>
-#include <QDir>
 #include <QMessageBox>
+#include <QProgressBar>
 
 RegisterWidget::RegisterWidget(QWidget *parent) : QWidget(parent)
 {
+    // 样式由应用级样式表（AppTheme）按页面对象名提供
+    setObjectName(AppTheme::REGISTER_PAGE);
     setupUI();
     applyStyles();
     setBackgroundImage();
@@ -68,6 +70,13 @@ void RegisterWidget::setupUI()
     m_nameLabel->setObjectName("fieldLabel");
     m_emailLabel->setObjectName("fieldLabel");
 
+    // 忙碌指示（不确定进度的进度条），注册请求进行中显示
+    m_busyIndicator = new QProgressBar(this);
+    m_busyIndicator->setRange(0, 0);
+    m_busyIndicator->setTextVisible(false);
+    m_busyIndicator->setMaximumHeight(6);
+    m_busyIndicator->hide();
+
     // 表单布局（四行：用户名、密码、姓名、邮箱）
     QFormLayout *formLayout = new QFormLayout();
     // 控制表单内左右控件之间的水平间距（标签 与 输入框）
@@ -98,6 +107,7 @@ void RegisterWidget::setupUI()
     QVBoxLayout *formAndButtons = new QVBoxLayout();
     formAndButtons->addLayout(formLayout);
     formAndButtons->addLayout(buttonsRow);
+    formAndButtons->addWidget(m_busyIndicator);
     // 避免默认 spacing 与 addSpacing 叠加导致距离偏大
     // 控制"表单区域 与 按钮区域"之间的垂直间距
     formAndButtons->setSpacing(18);
@@ -184,92 +194,26 @@ void RegisterWidget::applyStyles()
         layout()->setContentsMargins(24, 24, 24, 24);
         layout()->setSpacing(12);
     }
-
-    // 现代化外观样式（与登录界面一致）
-    this->setStyleSheet(
-        "#centerPanel { background: transparent; }"
-
-        /* 仅给标签添加纯蓝圆角背景与白字 */
-        "#fieldLabel {"
-            "background:#6CA6CD;"
-            "color:#ffffff;"
-            "border-radius:10px;"
-            "padding:2px 8px;"
-        "}"
-
-        /* 输入框：圆角、浅边框、聚焦高亮与阴影 */
-        "QLineEdit {"
-            "padding:6px 10px;"
-            "border:1px solid #6CA6CD;"
-            "border-radius:10px;"
-            "background:#ffffff;"
-        "}"
-        "QLineEdit:focus {"
-            "border-color:#6CA6CD;"
-            "background:#ffffff;"
-        "}"
-
-        /* 按钮：统一白色、圆角、浅边框、hover/pressed 态 */
-        "#backButton, #registerButton {"
-            "padding:0 14px;"
-            "border-radius:10px;"
-            "border:1px solid #6CA6CD;"
-            "background:#6CA6CD;"
-            "color:#ffffff;"
-        "}"
-        "#backButton:hover, #registerButton:hover { background:#6CA6CD; }"
-        "#backButton:pressed, #registerButton:pressed { background:#6CA6CD; }"
-    );
 }
 
 void RegisterWidget::setBackgroundImage()
 {
-    QString startDir = QCoreApplication::applicationDirPath();
-
-    QString path;
-    QString curDir = startDir;
-    for (int level = 0; level < 6 && path.isEmpty(); ++level) {
-        const QString base = curDir + "/resources/";
-        const QString jpg = base + "loginWidget.jpg";
-        const QString png = base + "loginWidget.png";
-        const bool jpgExists = QFile::exists(jpg);
-        const bool pngExists = QFile::exists(png);
-        if (jpgExists) {
-            path = jpg;
-            break;
-        }
-        if (pngExists) {
-            path = png;
-            break;
-        }
-        // 上移一层
-        curDir = QDir::cleanPath(curDir + "/..");
-    }
-
-    // 使用样式表 border-image 自适应填充，随窗口变化自动缩放
-    if (!path.isEmpty()) {
-        QPixmap probe(path);
-        if (!probe.isNull()) {
-            m_bgPixmap = probe;
-            update(); // 触发重绘
-        }
-
-        // 叠加样式，避免覆盖先前的控件样式
-        const QString prev = this->styleSheet();
-        this->setStyleSheet(prev + "\n" + QString(
-            "border-image: url(%1) 0 0 0 0 stretch stretch;"
-        ).arg(path));
-    }
+    // 背景图只在 paintEvent 中绘制一次（不再叠加 border-image 样式，避免重复绘制与整页样式重算）
+    // 图片由共享的 BackgroundImageCache 在后台解码并按尺寸缓存，解码完成后重绘
+    connect(BackgroundImageCache::instance(), &BackgroundImageCache::imageReady, this, [this]() {
+        update();
+    });
 }
 
 void RegisterWidget::paintEvent(QPaintEvent *event)
 {
-    if (!m_bgPixmap.isNull()) {
+    painttimer timer("register");
+    // 直接贴上当前尺寸的成品（已缩放并叠加透明度），尺寸不变时不再缩放
+    const QPixmap background = BackgroundImageCache::instance()->pixmap(
+        size(), devicePixelRatioF(), palette().color(QPalette::Window));
+    if (!background.isNull()) {
         QPainter p(this);
-        p.setRenderHint(QPainter::SmoothPixmapTransform, true);
-        const qreal opacity = 0.6;
-        p.setOpacity(opacity);
-        p.drawPixmap(rect(), m_bgPixmap);
+        p.drawPixmap(0, 0, background);
     }
     QWidget::paintEvent(event);
 }
@@ -309,6 +253,13 @@ void RegisterWidget::clearInputFields()
     m_emailEdit->clear();
 }
 
+void RegisterWidget::setBusy(bool busy)
+{
+    m_busyIndicator->setVisible(busy);
+    m_backButton->setEnabled(!busy);
+    m_registerButton->setEnabled(!busy);
+}
+
 void RegisterWidget::onRegisterButtonClicked()
 {
     if(!validateInput()){
@@ -10,6 +10,7 @@ class RegisterWidget : public QWidget
 public:
     RegisterWidget(QWidget *parent = nullptr);
     void clearInputFields();  // 清空所有输入框
+    void setBusy(bool busy);  // 注册请求进行中：显示忙碌指示并禁用按钮
 
 signals:
     void backToLogin();
@@ -38,7 +39,7 @@ private:
     class QPushButton *m_backButton;
     class QPushButton *m_registerButton;
     class QWidget *m_centerPanel;
-    QPixmap m_bgPixmap;
+    class QProgressBar *m_busyIndicator;
 };
 
 #endif // REGISTERWIDGET_H
@@ -0,0 +1,194 @@
+#include "userimportdialog.h"
+#include "../auth/authmanager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QPointer>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+
+UserImportDialog::UserImportDialog(AuthManager *authManager, QWidget *parent)
+    : QDialog(parent)
+    , m_authManager(authManager)
+    , m_watcher(new QFutureWatcher<importsummary>(this))
+    , m_fileEdit(nullptr)
+    , m_browseButton(nullptr)
+    , m_startButton(nullptr)
+    , m_cancelButton(nullptr)
+    , m_progressBar(nullptr)
+    , m_statusLabel(nullptr)
+    , m_errorTable(nullptr)
+{
+    setWindowTitle("批量导入用户");
+    setMinimumSize(600, 420);
+    setupUI();
+    connect(m_watcher, &QFutureWatcher<importsummary>::finished, this, &UserImportDialog::onImportFinished);
+}
+
+UserImportDialog::~UserImportDialog()
+{
+    // 导入任务引用了 m_importer，必须等待其结束
+    if (m_watcher->isRunning()) {
+        m_importer->cancel();
+        m_watcher->waitForFinished();
+    }
+}
+
+void UserImportDialog::setupUI()
+{
+    m_fileEdit = new QLineEdit(this);
+    m_fileEdit->setPlaceholderText("CSV 文件：username,email,name,password,permissions");
+    m_browseButton = new QPushButton("浏览...", this);
+    m_startButton = new QPushButton("开始导入", this);
+    m_cancelButton = new QPushButton("关闭", this);
+
+    m_progressBar = new QProgressBar(this);
+    m_progressBar->setRange(0, 100);
+    m_progressBar->setValue(0);
+
+    m_statusLabel = new QLabel("permissions 列为以分号分隔的功能编号（如 1;3;5），已存在的用户名会被跳过", this);
+    m_statusLabel->setWordWrap(true);
+
+    // 出错的行（最多显示导入器保留的条数）
+    m_errorTable = new QTableWidget(0, 3, this);
+    m_errorTable->setHorizontalHeaderLabels(QStringList() << "行号" << "用户名" << "原因");
+    m_errorTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_errorTable->verticalHeader()->hide();
+    m_errorTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+
+    connect(m_browseButton, &QPushButton::clicked, this, &UserImportDialog::onBrowseClicked);
+    connect(m_startButton, &QPushButton::clicked, this, &UserImportDialog::onStartClicked);
+    connect(m_cancelButton, &QPushButton::clicked, this, &UserImportDialog::onCancelClicked);
+
+    // 布局
+    QHBoxLayout *fileLayout = new QHBoxLayout();
+    fileLayout->addWidget(m_fileEdit);
+    fileLayout->addWidget(m_browseButton);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(m_startButton);
+    buttonLayout->addWidget(m_cancelButton);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addLayout(fileLayout);
+    mainLayout->addWidget(m_progressBar);
+    mainLayout->addWidget(m_statusLabel);
+    mainLayout->addWidget(m_errorTable);
+    mainLayout->addLayout(buttonLayout);
+}
+
+void UserImportDialog::onBrowseClicked()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "选择要导入的文件", QString(), "CSV 文件 (*.csv);;所有文件 (*)");
+    if (!path.isEmpty()) {
+        m_fileEdit->setText(path);
+    }
+}
+
+void UserImportDialog::onStartClicked()
+{
+    const QString path = m_fileEdit->text().trimmed();
+    if (path.isEmpty()) {
+        QMessageBox::warning(this, "提示", "请选择要导入的文件！");
+        return;
+    }
+    if (!m_authManager) {
+        QMessageBox::warning(this, "错误", "认证管理器未初始化！");
+        return;
+    }
+
+    m_errorTable->setRowCount(0);
+    m_progressBar->setValue(0);
+    m_statusLabel->setText("正在导入...");
+    setRunning(true);
+
+    // 进度在导入线程中回调，投递到界面线程更新（对话框关闭后丢弃）
+    QPointer<UserImportDialog> self(this);
+    m_importer.reset(new userimporter(m_authManager->getDatabaseManager()));
+    m_importer->setProgressCallback([self](const importprogress &progress) {
+        QMetaObject::invokeMethod(qApp, [self, progress]() {
+            if (self) {
+                self->updateProgress(progress);
+            }
+        }, Qt::QueuedConnection);
+    });
+
+    userimporter *importer = m_importer.get();
+    m_watcher->setFuture(QtConcurrent::run([importer, path]() {
+        return importer->importFile(path);
+    }));
+}
+
+void UserImportDialog::onCancelClicked()
+{
+    if (m_watcher->isRunning()) {
+        m_importer->cancel();
+        m_statusLabel->setText("正在取消，当前批次写入完成后停止...");
+        m_cancelButton->setEnabled(false);
+        return;
+    }
+    QDialog::reject();
+}
+
+void UserImportDialog::reject()
+{
+    onCancelClicked();
+}
+
+void UserImportDialog::onImportFinished()
+{
+    const importsummary summary = m_watcher->result();
+    setRunning(false);
+    updateProgress(summary.progress);
+
+    m_errorTable->setRowCount(summary.errors.size());
+    for (int i = 0; i < summary.errors.size(); ++i) {
+        const importerror &error = summary.errors.at(i);
+        m_errorTable->setItem(i, 0, new QTableWidgetItem(QString::number(error.line)));
+        m_errorTable->setItem(i, 1, new QTableWidgetItem(error.username));
+        m_errorTable->setItem(i, 2, new QTableWidgetItem(error.message));
+    }
+
+    const importprogress &progress = summary.progress;
+    QString text = QString("导入 %1 个用户，跳过 %2，失败 %3，用时 %4 秒")
+                       .arg(progress.imported).arg(progress.skipped).arg(progress.failed)
+                       .arg(summary.elapsedMs / 1000.0, 0, 'f', 1);
+    if (!summary.error.isEmpty()) {
+        text = QString("导入中止：%1\n%2").arg(summary.error, text);
+    } else if (summary.cancelled) {
+        text = "已取消：" + text;
+    } else {
+        m_progressBar->setValue(100);
+    }
+    m_statusLabel->setText(text);
+}
+
+void UserImportDialog::updateProgress(const importprogress &progress)
+{
+    if (progress.bytesTotal > 0) {
+        m_progressBar->setValue(int(progress.bytesRead * 100 / progress.bytesTotal));
+    }
+    if (m_watcher->isRunning()) {
+        m_statusLabel->setText(QString("已读取 %1 行，导入 %2，跳过 %3，失败 %4")
+                                   .arg(progress.rowsRead).arg(progress.imported)
+                                   .arg(progress.skipped).arg(progress.failed));
+    }
+}
+
+void UserImportDialog::setRunning(bool running)
+{
+    m_fileEdit->setEnabled(!running);
+    m_browseButton->setEnabled(!running);
+    m_startButton->setEnabled(!running);
+    m_cancelButton->setEnabled(true);
+    m_cancelButton->setText(running ? "取消" : "关闭");
+}
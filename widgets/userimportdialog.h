@@ -0,0 +1,53 @@
+#ifndef USERIMPORTDIALOG_H
+#define USERIMPORTDIALOG_H
+
+#include <QDialog>
+#include <QFutureWatcher>
+#include <memory>
+#include "../auth/userimporter.h"
+
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QProgressBar;
+class QTableWidget;
+class AuthManager;
+
+// 批量导入用户对话框（管理员）：选择 CSV 文件后在后台线程导入，显示进度与出错的行
+class UserImportDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit UserImportDialog(AuthManager *authManager, QWidget *parent = nullptr);
+    ~UserImportDialog() override;
+
+public slots:
+    // 导入进行中关闭窗口时先取消导入
+    void reject() override;
+
+private slots:
+    void onBrowseClicked();
+    void onStartClicked();
+    void onCancelClicked();
+    void onImportFinished();
+
+private:
+    void setupUI();
+    void updateProgress(const importprogress &progress);
+    void setRunning(bool running);
+
+    AuthManager *m_authManager;
+    std::unique_ptr<userimporter> m_importer;
+    QFutureWatcher<importsummary> *m_watcher;
+
+    QLineEdit *m_fileEdit;
+    QPushButton *m_browseButton;
+    QPushButton *m_startButton;
+    QPushButton *m_cancelButton;
+    QProgressBar *m_progressBar;
+    QLabel *m_statusLabel;
+    QTableWidget *m_errorTable;  // 出错的行（行号、用户名、原因）
+};
+
+#endif // USERIMPORTDIALOG_H